@@ -22,6 +22,7 @@
 
 // Headers needed by this particular selector
 #include "TLorentzVector.h"
+#include "../skimmers/engine/SkimTriggerCatalog.h"
 
 
 
@@ -35,6 +36,7 @@ public :
    TH1F* jpsiAll;
    
    int numtriggers = 16;
+   int fYear = 0;  // of the first run processed, for the catalog written out
 
    // Readers to access the data (delete the ones you do not need).
    TTreeReaderValue<UInt_t> run = {fReader, "run"};
@@ -47,6 +47,9 @@
 
 // Headers needed by this particular selector
 #include "TLorentzVector.h"
+#include "../../engine/SkimCandidates.h"
+#include "../../engine/SkimTriggerMenu.h"
+#include "../../engine/SkimTriggerCatalog.h"
 
 
 class TwoMuTwoK_2012 : public TSelector {
@@ -422,8 +425,19 @@ public :
    TTreeReaderArray<int> kaon2_Meas_byHits = {fReader, "kaon2_Meas_byHits"};
 
    Float_t out_MuMuMas_original,out_XMass_original;
+
+   // Candidates of the current event, see Process()
+   SkimCandidateBatch   fCands = SkimCandidateBatch(4, 64); //!
+   std::vector<Float_t> fMu1E, fMu2E;                       //!
+   std::vector<Float_t> fXMass, fMuMuMass, fKKMass;         //!
    Float_t out_TrigRes, out_TrigNames, out_MatchTriggerNames, out_L1TrigRes, out_evtNum;
    Float_t hlt8, hlt4;
+
+   // Versions of the 2012 paths (SkimTriggerCatalog), resolved once
+   // per run; fPathMasks[k] are the versions of catalog bit k
+   SkimTriggerMenu fTriggers;                               //!
+   ULong64_t       fPathMasks[SkimHLT::kN2012Paths];        //!
+   UInt_t          out_trigger;  // catalog word of the event
    Float_t event,run,lumi;
 
    Float_t out_kaonOnePx,out_kaonOnePy,out_kaonOnePz,out_kaonOneE,out_kaonOneChi2,out_kaonOneNDF;
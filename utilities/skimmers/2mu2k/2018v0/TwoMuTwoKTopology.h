@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////
+// SkimEngine topology for the 2018v0 J/psi phi skim, same
+// selection and output columns as TwoMuTwoKSkim.
+//////////////////////////////////////////////////////////
+
+#ifndef TwoMuTwoKTopology_h
+#define TwoMuTwoKTopology_h
+
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+#include <TLorentzVector.h>
+
+#include "../../engine/SkimTopology.h"
+
+class TwoMuTwoKTopology : public SkimTopology {
+public :
+   TTreeReader     fReader;  //!the tree reader
+
+   TTreeReaderValue<Int_t> run = {fReader, "run"};
+   TTreeReaderValue<Int_t> event = {fReader, "event"};
+   TTreeReaderValue<Int_t> trigger = {fReader, "trigger"};
+   TTreeReaderValue<TLorentzVector> dimuonditrk_p4 = {fReader, "dimuonditrk_p4"};
+   TTreeReaderValue<TLorentzVector> ditrak_p4 = {fReader, "ditrak_p4"};
+   TTreeReaderValue<TLorentzVector> dimuon_p4 = {fReader, "dimuon_p4"};
+   TTreeReaderValue<TLorentzVector> dimuonditrk_rf_p4 = {fReader, "dimuonditrk_rf_p4"};
+   TTreeReaderValue<TLorentzVector> ditrak_rf_p4 = {fReader, "ditrak_rf_p4"};
+   TTreeReaderValue<TLorentzVector> dimuon_rf_p4 = {fReader, "dimuon_rf_p4"};
+   TTreeReaderValue<TLorentzVector> muonp_rf_p4 = {fReader, "muonp_rf_p4"};
+   TTreeReaderValue<TLorentzVector> muonn_rf_p4 = {fReader, "muonn_rf_p4"};
+   TTreeReaderValue<TLorentzVector> kaonp_rf_p4 = {fReader, "kaonp_rf_p4"};
+   TTreeReaderValue<TLorentzVector> kaonn_rf_p4 = {fReader, "kaonn_rf_p4"};
+   TTreeReaderValue<Int_t> dimuon_triggerMatch = {fReader, "dimuon_triggerMatch"};
+   TTreeReaderValue<Double_t> dimuonditrk_vProb = {fReader, "dimuonditrk_vProb"};
+   TTreeReaderValue<Double_t> dimuonditrk_cosAlpha = {fReader, "dimuonditrk_cosAlpha"};
+   TTreeReaderValue<Double_t> dimuonditrk_ctauPV = {fReader, "dimuonditrk_ctauPV"};
+   TTreeReaderValue<Double_t> dimuonditrk_ctauErrPV = {fReader, "dimuonditrk_ctauErrPV"};
+
+   TwoMuTwoKTopology() : SkimTopology("JPsiPhiTree", "rootuple", "outuple") { }
+   virtual ~TwoMuTwoKTopology() { }
+
+   virtual SkimTopology *Clone() const { return new TwoMuTwoKTopology(); }
+   virtual void    Book(TTree *outTree);
+   virtual void    Init(TTree *tree) { fReader.SetTree(tree); }
+   virtual Bool_t  Process(Long64_t entry);
+
+   static const Int_t kNOut = 17;
+   Int_t   out_run, out_evt, out_hlt;
+   Float_t out[kNOut];
+};
+
+#endif
@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////
+// SkimBestCandidate: best candidate arbitration as a pass over
+// an existing skim, so changing the ranking does not mean
+// rerunning the skim.
+//
+// The candidates of an event are consecutive rows of the tree
+// (as the rootuplers write them and SkimEngine keeps them, see
+// SkimEngine::SetBestCandidate), so the pass streams the tree
+// block by block and only holds the rows of the current
+// (run, event). The ranking is an expression of the tree
+// columns (SkimFormula syntax), the highest or lowest value
+// wins:
+//
+//   SkimBestCandidate best;
+//   best.SetRanking("vProb");                        // highest vertex probability
+//   best.SetMassRanking("xM", 3.096900);             // closest to the J/psi mass
+//   best.SetRanking("vProb - 10 * abs(xM - 4.140)"); // composite score
+//   best.Process("2mu2k_tree.root", "2mu2ktree", "2mu2k_best.root");
+//
+// kWinner writes a copy of the tree with one row per event,
+// kRank a friend tree (one row per input row) with the rank of
+// the row in its event (0 is the best), the number of
+// candidates of the event and the score.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimBestCandidate_h
+#define SkimBestCandidate_h
+
+#include <TTree.h>
+#include <TString.h>
+
+#include <vector>
+
+class SkimBestCandidate {
+public :
+   enum EOrder  { kHighest, kLowest };
+   enum EOutput { kWinner, kRank };
+
+   SkimBestCandidate(const char *runName = "run", const char *eventName = "event")
+     : fRunName(runName), fEventName(eventName), fOrder(kHighest), fMode(kWinner),
+       fTree(0), fOutTree(0), fRank(0), fNCandidates(0), fScore(0), fWritten(0) { }
+   virtual ~SkimBestCandidate() { }
+
+   void     SetRanking(const char *expression, EOrder order = kHighest)
+   {
+     fRanking = expression;
+     fOrder = order;
+   }
+   // |mass - pdgMass|, the lowest wins
+   void     SetMassRanking(const char *mass, Double_t pdgMass)
+   {
+     SetRanking(TString::Format("abs(%s - %.9g)", mass, pdgMass), kLowest);
+   }
+
+   const char *GetRunName() const   { return fRunName.Data(); }
+   const char *GetEventName() const { return fEventName.Data(); }
+   const char *GetRanking() const   { return fRanking.Data(); }
+
+   // Arbitrates treeName of input into output, returns the number of
+   // rows written (-1 on error)
+   Long64_t Process(const char *input, const char *treeName, const char *output, EOutput mode = kWinner);
+
+private :
+   // Writes the open event and starts a new one
+   void     Flush();
+   Bool_t   Better(Double_t a, Double_t b) const;
+
+   TString  fRunName;
+   TString  fEventName;
+   TString  fRanking;
+   EOrder   fOrder;
+
+   // Rows of the open event
+   std::vector<Long64_t>  fRows;
+   std::vector<Double_t>  fScores;
+
+   // Output state of Process()
+   EOutput  fMode;
+   TTree   *fTree;
+   TTree   *fOutTree;
+   Int_t    fRank;
+   Int_t    fNCandidates;
+   Float_t  fScore;
+   Long64_t fWritten;
+};
+
+#endif
@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////
+// SkimCandidates: a batch of multi-track candidates stored as
+// structure of arrays, and the mass hypotheses to apply to it.
+//
+// Each candidate has the same track slots (e.g. the two muons
+// and the four tracks of a six tracks candidate); the batch keeps
+// one px, py and pz array per slot, so a mass hypothesis is a
+// mass per slot and every invariant mass is computed for the
+// whole batch by the SkimMassKernels:
+//
+//   SkimCandidateBatch batch(6);
+//   ... batch.SetTrack(i, slot, p4) for a cluster of entries ...
+//   SkimHypothesis mumukk("mumukk", "mu mu K K - -");
+//   batch.Masses(mumukk, out);
+//
+// New hypotheses are a new string, not a new ntuplizer column.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimCandidates_h
+#define SkimCandidates_h
+
+#include <Rtypes.h>
+#include <TString.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TError.h>
+#include <TLorentzVector.h>
+
+#include <cmath>
+#include <vector>
+
+#include "SkimMassKernels.h"
+
+// One mass per slot of the batch; slots assigned "-" are left out
+// of the combination
+class SkimHypothesis {
+public :
+   // assignment: one of mu, pi, K, p or - per slot, blank separated
+   SkimHypothesis(const char *name, const char *assignment) : fName(name)
+   {
+     TObjArray *items = TString(assignment).Tokenize(" ");
+     for (Int_t slot = 0; slot < items->GetEntriesFast(); ++slot)
+     {
+       TString what = ((TObjString *) items->At(slot))->GetString();
+       Double_t mass = -1;
+       if (what == "mu")
+         mass = kSkimMuonMass;
+       else if (what == "pi")
+         mass = kSkimPionMass;
+       else if (what == "K")
+         mass = kSkimKaonMass;
+       else if (what == "p")
+         mass = kSkimProtonMass;
+       else if (what != "-")
+         ::Error("SkimHypothesis::SkimHypothesis", "%s: unknown particle %s in slot %d", name, what.Data(), slot);
+       if (mass >= 0)
+       {
+         fSlots.push_back(slot);
+         fMasses.push_back(mass);
+       }
+     }
+     delete items;
+   }
+
+   const char *GetName() const { return fName.Data(); }
+   Int_t    GetN() const           { return (Int_t) fSlots.size(); }
+   Int_t    GetSlot(Int_t k) const { return fSlots[k]; }
+   Double_t GetMass(Int_t k) const { return fMasses[k]; }
+
+private :
+   TString               fName;
+   std::vector<Int_t>    fSlots;
+   std::vector<Double_t> fMasses;
+};
+
+class SkimCandidateBatch {
+public :
+   SkimCandidateBatch(Int_t nSlots, Int_t capacity = 4096)
+     : fNSlots(nSlots), fSize(0), fCapacity(0)
+   {
+     Reserve(capacity);
+   }
+
+   Int_t GetNSlots() const { return fNSlots; }
+   Int_t GetSize() const   { return fSize; }
+
+   void  Clear() { fSize = 0; }
+
+   // Appends an empty candidate, returns its index
+   Int_t Add()
+   {
+     if (fSize == fCapacity)
+       Reserve(2 * fCapacity);
+     return fSize++;
+   }
+
+   void  SetTrack(Int_t cand, Int_t slot, Float_t px, Float_t py, Float_t pz)
+   {
+     Px(slot)[cand] = px;
+     Py(slot)[cand] = py;
+     Pz(slot)[cand] = pz;
+   }
+   void  SetTrack(Int_t cand, Int_t slot, const TLorentzVector &p4)
+   {
+     SetTrack(cand, slot, p4.Px(), p4.Py(), p4.Pz());
+   }
+   void  SetTrackPtEtaPhi(Int_t cand, Int_t slot, Float_t pt, Float_t eta, Float_t phi)
+   {
+     SetTrack(cand, slot, pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta));
+   }
+
+   Float_t       *Px(Int_t slot)       { return &fP[(3 * slot) * fCapacity]; }
+   Float_t       *Py(Int_t slot)       { return &fP[(3 * slot + 1) * fCapacity]; }
+   Float_t       *Pz(Int_t slot)       { return &fP[(3 * slot + 2) * fCapacity]; }
+   const Float_t *Px(Int_t slot) const { return &fP[(3 * slot) * fCapacity]; }
+   const Float_t *Py(Int_t slot) const { return &fP[(3 * slot + 1) * fCapacity]; }
+   const Float_t *Pz(Int_t slot) const { return &fP[(3 * slot + 2) * fCapacity]; }
+
+   // Kernel input for a slot, with a mass or a per-candidate energy array
+   SkimMassInput Input(Int_t slot, Double_t mass) const { return SkimMassInput(Px(slot), Py(slot), Pz(slot), mass); }
+   SkimMassInput Input(Int_t slot, const Float_t *e) const { return SkimMassInput(Px(slot), Py(slot), Pz(slot), e); }
+
+   // Invariant mass of the slots of hypothesis for every candidate
+   // of the batch, out must hold GetSize() values
+   Bool_t Masses(const SkimHypothesis &hypothesis, Float_t *out) const
+   {
+     SkimMassInput in[6];
+     Int_t n = hypothesis.GetN();
+     if (n > 6)
+     {
+       ::Error("SkimCandidateBatch::Masses", "%s: at most 6 particles", hypothesis.GetName());
+       return kFALSE;
+     }
+     for (Int_t k = 0; k < n; ++k)
+     {
+       if (hypothesis.GetSlot(k) >= fNSlots)
+       {
+         ::Error("SkimCandidateBatch::Masses", "%s: no slot %d", hypothesis.GetName(), hypothesis.GetSlot(k));
+         return kFALSE;
+       }
+       in[k] = Input(hypothesis.GetSlot(k), hypothesis.GetMass(k));
+     }
+     return SkimMass::Compute(in, n, fSize, out);
+   }
+
+private :
+   // Grows every slot array to capacity, keeping the candidates
+   void  Reserve(Int_t capacity)
+   {
+     if (capacity < 1)
+       capacity = 1;
+     std::vector<Float_t> p(3 * fNSlots * capacity, 0);
+     for (Int_t a = 0; a < 3 * fNSlots; ++a)
+       for (Int_t i = 0; i < fSize; ++i)
+         p[a * capacity + i] = fP[a * fCapacity + i];
+     fP.swap(p);
+     fCapacity = capacity;
+   }
+
+   Int_t                 fNSlots;
+   Int_t                 fSize;
+   Int_t                 fCapacity;
+   std::vector<Float_t>  fP;      // [slot][px, py, pz][candidate]
+};
+
+#endif
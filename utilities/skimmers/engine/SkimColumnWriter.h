@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////
+// SkimColumnWriter: typed replacement of the TNtuple outputs of the
+// selectors (every column a float: trigger words and run numbers
+// rounded, flags four bytes wide).
+//
+// The columns are declared as a TTree leaf list, every one with its
+// own type, and filled in order as TNtuple::Fill() was:
+//
+//   SkimColumnWriter *out = new SkimColumnWriter("outuple", "outuple", "run/i:xM/F:phiHLT/O:matchMN/i");
+//   out->Fill(*run, (*dimuonditrak_p4).M(), phiHLT, *muonN_tMatch);
+//   ...
+//   out->Write();
+//
+// Values are converted once to the column type (integers keep every
+// bit) and stored straight into the record the branches point to;
+// Next() (or Fill()) fills the tree with it. Types: O (Bool_t),
+// B b S s I i L l (signed/unsigned integers of 1, 2, 4, 8 bytes),
+// F, D. The tree is made in the current directory, as the TNtuple
+// was.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimColumnWriter_h
+#define SkimColumnWriter_h
+
+#include <TTree.h>
+#include <TString.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TError.h>
+
+#include <vector>
+
+#include "SkimSchema.h"
+
+class SkimColumnWriter {
+public :
+   SkimColumnWriter(const char *name, const char *title, const char *columns)
+     : fTree(0), fRecordBytes(0)
+   {
+     fTree = new TTree(name, title);
+     TObjArray *items = TString(columns).Tokenize(":");
+     for (Int_t k = 0; k < items->GetEntriesFast(); ++k)
+     {
+       TString item = ((TObjString *) items->At(k))->GetString();
+       Int_t slash = item.Last('/');
+       ESkimType type = slash > 0 ? Type(item[slash + 1]) : kSkimFloat;
+       if (type == kSkimAuto)
+       {
+         ::Error("SkimColumnWriter::SkimColumnWriter", "%s: unknown type, written as float", item.Data());
+         type = kSkimFloat;
+       }
+       fNames.push_back(slash > 0 ? TString(item(0, slash)) : item);
+       fTypes.push_back(type);
+       // Every value aligned on its size
+       Int_t size = Size(type);
+       fRecordBytes = (fRecordBytes + size - 1) / size * size;
+       fOffsets.push_back(fRecordBytes);
+       fRecordBytes += size;
+     }
+     delete items;
+     fRecordBytes = (fRecordBytes + 7) / 8 * 8;
+
+     fRecord.assign(fRecordBytes / 8, 0);
+     for (UInt_t c = 0; c < fNames.size(); ++c)
+       fTree->Branch(fNames[c], (char *) fRecord.data() + fOffsets[c], fNames[c] + "/" + Code(fTypes[c]));
+   }
+
+   // The tree belongs to its directory
+   virtual ~SkimColumnWriter() { }
+
+   TTree   *GetTree() const { return fTree; }
+   Int_t    GetNColumns() const { return (Int_t) fNames.size(); }
+
+   // Column of the current row, converted to its type
+   template <class T>
+   void     Set(Int_t column, T value)
+   {
+     char *p = (char *) fRecord.data() + fOffsets[column];
+     switch (fTypes[column])
+     {
+       case kSkimBool:    *(Bool_t *) p    = value != 0;           break;
+       case kSkimChar:    *(Char_t *) p    = (Char_t) value;       break;
+       case kSkimUChar:   *(UChar_t *) p   = (UChar_t) value;      break;
+       case kSkimShort:   *(Short_t *) p   = (Short_t) value;      break;
+       case kSkimUShort:  *(UShort_t *) p  = (UShort_t) value;     break;
+       case kSkimInt:     *(Int_t *) p     = (Int_t) value;        break;
+       case kSkimUInt:    *(UInt_t *) p    = (UInt_t) value;       break;
+       case kSkimLong64:  *(Long64_t *) p  = (Long64_t) value;     break;
+       case kSkimULong64: *(ULong64_t *) p = (ULong64_t) value;    break;
+       case kSkimDouble:  *(Double_t *) p  = (Double_t) value;     break;
+       default:           *(Float_t *) p   = (Float_t) value;      break;
+     }
+   }
+
+   // Row done, into the tree
+   Int_t    Next() { return fTree->Fill(); }
+
+   // Whole row, the values in the column order
+   template <class... Values>
+   Int_t    Fill(Values... values)
+   {
+     if ((Int_t) sizeof...(values) != GetNColumns())
+     {
+       ::Error("SkimColumnWriter::Fill", "%d values for %d columns", (Int_t) sizeof...(values), GetNColumns());
+       return -1;
+     }
+     SetFrom(0, values...);
+     return Next();
+   }
+
+   // Writes the tree to its directory
+   Int_t    Write() { return fTree->Write(); }
+
+private :
+   void     SetFrom(Int_t) { }
+
+   template <class T, class... Rest>
+   void     SetFrom(Int_t column, T value, Rest... rest)
+   {
+     Set(column, value);
+     SetFrom(column + 1, rest...);
+   }
+
+   // Leaf codes of SkimSchema::LeafCode(), here so that the selectors
+   // only include the header (no SkimSchema.C to load on the workers)
+   static ESkimType Type(Char_t code)
+   {
+     switch (code)
+     {
+       case 'O': return kSkimBool;
+       case 'B': return kSkimChar;
+       case 'b': return kSkimUChar;
+       case 'S': return kSkimShort;
+       case 's': return kSkimUShort;
+       case 'I': return kSkimInt;
+       case 'i': return kSkimUInt;
+       case 'L': return kSkimLong64;
+       case 'l': return kSkimULong64;
+       case 'F': return kSkimFloat;
+       case 'D': return kSkimDouble;
+       default:  return kSkimAuto;
+     }
+   }
+
+   static const char *Code(ESkimType type)
+   {
+     static const char *codes[] = { "O", "B", "b", "S", "s", "I", "i", "L", "l", "F", "D" };
+     return type <= kSkimDouble ? codes[type] : "F";
+   }
+
+   static Int_t Size(ESkimType type)
+   {
+     static const Int_t sizes[] = { sizeof(Bool_t), sizeof(Char_t), sizeof(UChar_t), sizeof(Short_t), sizeof(UShort_t),
+                                    sizeof(Int_t), sizeof(UInt_t), sizeof(Long64_t), sizeof(ULong64_t), sizeof(Float_t),
+                                    sizeof(Double_t) };
+     return type <= kSkimDouble ? sizes[type] : sizeof(Float_t);
+   }
+
+   TTree                 *fTree;
+   std::vector<TString>   fNames;
+   std::vector<ESkimType> fTypes;
+   std::vector<Int_t>     fOffsets;      // bytes into a record
+   Int_t                  fRecordBytes;  // multiple of 8
+   std::vector<ULong64_t> fRecord;       // the branch addresses
+};
+
+#endif
@@ -0,0 +1,41 @@
+//////////////////////////////////////////////////////////
+// SkimCompression: named compression profiles for skim outputs
+// and a benchmark to choose between them on a real skim.
+//
+// Intermediate skims are reread many times by the fitters and
+// want fast decompression, archived ones want the smallest size:
+//
+//   hot, lz4      LZ4 level 4
+//   zlib          ZLIB level 1 (what the selectors used to write)
+//   zstd          ZSTD level 5 (ROOT 6.20 and later)
+//   archive, lzma LZMA level 9
+//
+// or "<algorithm>:<level>", e.g. "lz4:9". Used through
+// SkimEngine::SetCompression(), or
+//
+//   root> SkimCompression::Bench("2mu4k_six_tree.root", "SixTrackSkimmedTree", "lz4 zlib lzma");
+//
+// which rewrites the tree with every profile and prints the
+// compression ratio and the write and read speeds (MB/s of
+// uncompressed data).
+//////////////////////////////////////////////////////////
+
+#ifndef SkimCompression_h
+#define SkimCompression_h
+
+#include <TString.h>
+
+class SkimCompression {
+public :
+   // ROOT compression settings (algorithm * 100 + level), -1 if unknown
+   static Int_t  Settings(const char *profile);
+
+   // Rewrites treeName of skim once per blank separated profile into
+   // scratch files (removed afterwards), basketSize and autoFlush as in
+   // SkimEngine::SetCompression(), kFALSE on error. No profiles: lz4,
+   // zlib, zstd (where the ROOT version has it) and lzma
+   static Bool_t Bench(const char *skim, const char *treeName, const char *profiles = 0,
+                       Int_t basketSize = 0, Long64_t autoFlush = 0);
+};
+
+#endif
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////
+// SkimDataset: dataset manifest, replacing the dataset->Add()
+// lists pasted in the Run.*.C macros.
+//
+// A manifest is a text file of "key: value" lines, '#' starts a
+// comment:
+//
+//   name:  charmonium2018_sixtracks
+//   era:   A B C D
+//   year:  2018
+//   tree:  SixTracksTree
+//   dir:   rootupleSix
+//   file:  /lustre/cms/store/user/adiflori/Charmonium/crab_*_Run2018A-*_six_five/*/00*.root
+//   file:  /lustre/.../0001.root 1234567     # entries already known
+//
+// File names may have shell wildcards (* ? [...]) in any path
+// component. The resolver expands them and gets the entries of
+// every file (and its MD5 when asked) once: they are cached by path,
+// size and modification time, so a job starts without opening every
+// input just to count its entries. The cache is kept out of the
+// source tree, in $TMPDIR (or SetCacheDir(), e.g. the output
+// directory), one file per manifest, see GetCacheName().
+//
+//   SkimDataset dataset("datasets/charmonium2018_sixtracks.txt");
+//   engine.Add(dataset);                 // entry ranges known up front
+//   TDSet *set = dataset.MakeDataSet();  // same for PROOF
+//   dataset.Chunks(40, chunks);          // ranges of at most 1/40 of the entries
+//////////////////////////////////////////////////////////
+
+#ifndef SkimDataset_h
+#define SkimDataset_h
+
+#include <TString.h>
+#include <TDSet.h>
+
+#include <vector>
+
+struct SkimDatasetFile {
+   TString  fFile;
+   Long64_t fEntries;   // -1 if unknown
+   TString  fChecksum;  // MD5, empty unless asked for
+};
+
+// Entries [fFirst, fFirst + fNum) of file fFile of the dataset
+struct SkimDatasetChunk {
+   Int_t    fFile;
+   Long64_t fFirst;
+   Long64_t fNum;
+};
+
+class SkimDataset {
+public :
+   SkimDataset() : fYear(0) { }
+   SkimDataset(const char *manifest, Bool_t checksums = kFALSE) : fYear(0) { Read(manifest, checksums); }
+   virtual ~SkimDataset() { }
+
+   // Parses and resolves manifest, kFALSE on error
+   Bool_t   Read(const char *manifest, Bool_t checksums = kFALSE);
+
+   const char *GetName() const     { return fName.Data(); }
+   const char *GetEra() const      { return fEra.Data(); }
+   Int_t       GetYear() const     { return fYear; }
+   const char *GetTreeName() const { return fTreeName.Data(); }
+   const char *GetDirName() const  { return fDirName.Data(); }
+   TString     GetTreePath() const { return fDirName.IsNull() ? fTreeName : fDirName + "/" + fTreeName; }
+
+   Int_t    GetNFiles() const { return (Int_t) fFiles.size(); }
+   const SkimDatasetFile &GetFile(Int_t i) const { return fFiles[i]; }
+   Long64_t GetEntries() const;
+
+   // Splits the dataset in entry ranges of at most 1/n of its entries,
+   // returns their number. A range does not cross files, so there are
+   // up to n + GetNFiles() of them and the last one of each file is
+   // shorter.
+   Int_t    Chunks(Int_t n, std::vector<SkimDatasetChunk> &chunks) const;
+
+   // TDSet of the files, with their entries when known
+   TDSet   *MakeDataSet() const;
+
+   // Directory of the entry caches, empty: gSystem->TempDirectory()
+   static void    SetCacheDir(const char *dir) { fgCacheDir = dir; }
+   // <cache dir>/<manifest name>.<hash of its full path>.cache
+   static TString GetCacheName(const char *manifest);
+
+private :
+   Bool_t   Expand(const TString &pattern, std::vector<TString> &files) const;
+   Bool_t   Resolve(const char *manifest, Bool_t checksums);
+
+   TString  fName;
+   TString  fEra;
+   Int_t    fYear;
+   TString  fTreeName;
+   TString  fDirName;
+   std::vector<SkimDatasetFile> fFiles;
+
+   static TString fgCacheDir;
+};
+
+#endif
@@ -0,0 +1,212 @@
+//////////////////////////////////////////////////////////
+// SkimEngine: multithreaded replacement for the PROOF driven
+// selectors in utilities/skimmers.
+//
+// The input files (plain list or the TDSet the Run.*.C macros
+// already build) are split into entry ranges on basket cluster
+// boundaries, the ranges are handed to a work-stealing pool of
+// threads inside this process and each thread writes its own buffer
+// of the output, merged into the requested output file while the
+// skim runs. The busy time of every thread is printed at the end,
+// the per-stage counters and cut-flow go to <output>_stats.json.
+//
+// root> .L SkimEngine.C+
+// root> .L TwoMuTwoKTopology.C+
+// root> SkimEngine engine(64);
+// root> engine.Add(SkimDataset("../datasets/charmonium2018_sixtracks.txt"));
+// root> engine.Process(TwoMuTwoKTopology(), "2mu2k_tree.root");
+//////////////////////////////////////////////////////////
+
+#ifndef SkimEngine_h
+#define SkimEngine_h
+
+#include <TROOT.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <TString.h>
+#include <TDSet.h>
+#include <ROOT/TBufferMerger.hxx>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "SkimTopology.h"
+#include "SkimPool.h"
+#include "SkimBestCandidate.h"
+#include "SkimEventIndex.h"
+#include "SkimReadAhead.h"
+#include "SkimCompression.h"
+#include "SkimDataset.h"
+#include "SkimStats.h"
+#include "SkimTriggerCatalog.h"
+
+// One unit of work: entries [fFirst, fLast) of input fInput
+struct SkimUnit {
+   Int_t    fInput;
+   Long64_t fFirst;
+   Long64_t fLast;
+   Bool_t   fToClusters;  // boundaries moved to cluster starts by the worker
+};
+
+// What one worker did, printed at the end of SkimEngine::Process()
+struct SkimWorkerStats {
+   Int_t    fUnits;
+   Int_t    fStolen;
+   Long64_t fEntries;
+   Double_t fBusy;  // s spent opening inputs and processing units
+   Double_t fDone;  // s from the start of the pool to the last unit
+};
+
+class SkimEngine {
+public :
+   SkimEngine(Int_t nThreads = 0);
+   virtual ~SkimEngine() { }
+
+   // Input tree path defaults to the topology dir/tree when empty
+   void     Add(const char *file, const char *treePath = "", Long64_t first = 0, Long64_t num = -1);
+   void     Add(TDSet *dataset);
+   // Manifest inputs: files with known entries are not opened to
+   // build the units. The year of the manifest, if any, selects the
+   // trigger table stored in the output (see SetTriggerYear()).
+   void     Add(const SkimDataset &dataset);
+
+   void     SetNThreads(Int_t nThreads);
+   void     SetEntriesPerUnit(Long64_t entries) { fEntriesPerUnit = entries; }
+   // Unit boundaries on basket cluster starts (default), so no cluster
+   // is read and unzipped by two workers. A unit is then at least one
+   // cluster, the units left empty are skipped.
+   void     SetClusterAlign(Bool_t align = kTRUE) { fClusterAlign = align; }
+
+   // Cuts file or ';' separated expressions replacing the selection
+   // of the topology, see SkimSelection::ReadCuts()
+   void     SetCuts(const char *cuts) { fCuts = cuts; }
+
+   // Named cut variants (same syntax as SetCuts) evaluated in the same
+   // pass: one output tree with the entries passing any variant and a
+   // "cutVariants" bitmask branch, bit k for the k-th variant added
+   void     AddVariant(const char *name, const char *cuts);
+
+   // Keeps the candidates of an event in one unit of work (unit
+   // boundaries move to the next change of the inRun/inEvent input
+   // branches) so every event is contiguous in the output, and, when
+   // best has a ranking, arbitrates the merged output into
+   // <output>_best.root (kWinner) or <output>_rank.root (kRank)
+   void     SetBestCandidate(const SkimBestCandidate &best,
+                             SkimBestCandidate::EOutput mode = SkimBestCandidate::kWinner,
+                             const char *inRun = "run", const char *inEvent = "event");
+   // Writes the (run, lumi, event) index of the merged output next to
+   // it, see SkimEventIndex. Output branch names, lumi may be empty.
+   void     SetEventIndex(const char *run = "run", const char *lumi = "lumi", const char *event = "event");
+
+   // Input pipeline, see SkimReadAhead: number of units prepared ahead
+   // per worker (0: none), tree cache size and parallel unzipping
+   void     SetReadAhead(Int_t depth) { fReadAhead = depth; }
+   void     SetCacheSize(Long64_t bytes) { fCacheSize = bytes; }
+   void     SetParallelUnzip(Bool_t unzip = kTRUE) { fParallelUnzip = unzip; }
+
+   // Output compression profile (see SkimCompression, e.g. "hot" for
+   // skims reread by the fitters, "archive" for the final ones), and
+   // basket size and auto-flush of the output tree (0: ROOT defaults)
+   Bool_t   SetCompression(const char *profile, Int_t basketSize = 0, Long64_t autoFlush = 0);
+
+   // Workers write into one TBufferMerger, merged while they run,
+   // instead of one file each merged at the end (default). Off, or
+   // with a journal, the pieces are fast merged after the skim.
+   void     SetParallelMerge(Bool_t merge = kTRUE) { fParallelMerge = merge; }
+
+   // Journal of the units done: every unit is written to its own piece
+   // and recorded in journal once closed, a job started again with the
+   // same inputs, output and journal skips them. Removed with the
+   // pieces after a successful merge.
+   void     SetJournal(const char *journal) { fJournal = journal; }
+
+   // Progress line (entries, bytes read, rates, selected) every seconds
+   // while the skim runs, 0 for none
+   void     SetMonitor(Int_t seconds) { fMonitor = seconds; }
+   // Per-stage counters and cut-flow of the job (see SkimStats), by
+   // default in <output>_stats.json. Without stage stats the topology
+   // loops take no timestamps and count no cut-flow, the entries and
+   // bytes are still counted.
+   void     SetStatsFile(const char *json) { fStatsFile = json; }
+   void     SetStageStats(Bool_t stats = kTRUE) { fStageStats = stats; }
+
+   // Year of the trigger table of SkimTriggerCatalog stored in the
+   // UserInfo of the output tree, 0 for none
+   void     SetTriggerYear(Int_t year) { fTriggerYear = year; }
+
+   Int_t    GetNThreads() const { return fNThreads; }
+
+   // Runs the skim, returns the number of selected entries (-1 on error)
+   Long64_t Process(const SkimTopology &topology, const char *output);
+
+private :
+   struct SkimInput {
+     TString  fFile;
+     TString  fTreePath;
+     Long64_t fFirst;
+     Long64_t fNum;
+   };
+
+   Int_t    BuildUnits(const SkimTopology &topology);
+   Long64_t EventEnd(TTree *tree, Long64_t entry, Long64_t last) const;
+   void     Work(Int_t worker, SkimPool &pool, const SkimTopology &topology);
+   TTree   *OpenPiece(const char *piece, SkimTopology *topo, TFile *&out) const;
+   TTree   *BookTree(SkimTopology *topo, TDirectory *dir) const;
+   void     ClosePiece(TFile *&out, TTree *outTree) const;
+   SkimReadAheadUnit ReadAheadUnit(Int_t task) const;
+   TString  UnitKey(Int_t task) const;
+   void     Commit(Int_t task, Long64_t selected);
+   Long64_t Resume(std::vector<Bool_t> &done) const;
+   Bool_t   Merge(const char *output);
+   Bool_t   Configure(SkimTopology *topo) const;
+   void     ReportVariants(const char *output, const SkimTopology &topology) const;
+   void     ReportWorkers(Double_t wall) const;
+   void     ReportStats(const char *output, const SkimTopology &topology, const SkimStats &total,
+                        Double_t wall, Int_t resumed) const;
+   SkimStats Progress() const;
+   void     Monitor();
+   TString  PieceName(const char *output, Int_t worker) const;
+   TString  UnitName(const char *output, Int_t unit) const;
+
+   Int_t                   fNThreads;
+   Long64_t                fEntriesPerUnit;
+   Bool_t                  fClusterAlign;
+   Int_t                   fMonitor;  // s between progress lines
+   TString                 fStatsFile;
+   Bool_t                  fStageStats;
+   Int_t                   fTriggerYear;
+   Int_t                   fReadAhead;
+   Long64_t                fCacheSize;
+   Bool_t                  fParallelUnzip;
+   Int_t                   fCompression;  // -1: ROOT default
+   Int_t                   fBasketSize;
+   Long64_t                fAutoFlush;
+   Bool_t                  fParallelMerge;
+   ROOT::Experimental::TBufferMerger *fBufferMerger;
+   TString                 fCuts;
+   std::vector<TString>    fVariantNames;
+   std::vector<TString>    fVariantCuts;
+   Bool_t                  fAlignEvents;
+   TString                 fAlignRun;
+   TString                 fAlignEvent;
+   SkimBestCandidate       fBest;
+   SkimBestCandidate::EOutput fBestMode;
+   TString                 fIndexKeys[3];  // run, lumi, event, empty run: no index
+   TString                 fJournal;
+   std::mutex              fJournalMutex;
+   std::vector<SkimInput>  fInputs;
+   std::vector<SkimUnit>   fUnits;
+   std::vector<TString>    fPieces;    // per worker output files, per unit with a journal
+   std::vector<Long64_t>   fSelected;  // per worker selected entries
+   std::vector<SkimWorkerStats> fWorkerStats;
+   std::chrono::steady_clock::time_point fPoolStart;
+   std::vector<SkimStats>  fPipeline;  // per worker, updated after each unit
+   mutable std::mutex      fPipelineMutex;
+   std::mutex              fMonitorMutex;
+   std::condition_variable fMonitorCond;
+   Bool_t                  fMonitorDone;
+};
+
+#endif
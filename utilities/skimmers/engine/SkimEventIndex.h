@@ -0,0 +1,93 @@
+//////////////////////////////////////////////////////////
+// SkimEventIndex: sorted (run, lumi, event) -> entry range index
+// of a skim tree, kept in a small binary file next to the skim
+// (2mu2k_tree.root -> 2mu2k_tree.idx).
+//
+// Each record is one run of consecutive entries with the same
+// key (the candidates of an event), the records are sorted by
+// key, so a lookup is a binary search and two indexes can be
+// walked side by side for an event level join between skims of
+// different topologies:
+//
+//   SkimEventIndex index;
+//   index.Read(SkimEventIndex::IndexName("2mu2k_tree.root"));
+//   std::vector<SkimEventRange> ranges;
+//   if (index.Find(run, lumi, event, ranges))
+//     for (entry = ranges[0].fFirst; entry < ranges[0].fFirst + ranges[0].fN; ++entry) ...
+//
+// Built by SkimEngine::SetEventIndex() after the merge, or on an
+// existing skim with SkimEventIndex::Index().
+//////////////////////////////////////////////////////////
+
+#ifndef SkimEventIndex_h
+#define SkimEventIndex_h
+
+#include <TTree.h>
+#include <TString.h>
+
+#include <vector>
+
+struct SkimEventKey {
+   UInt_t    fRun;
+   UInt_t    fLumi;
+   ULong64_t fEvent;
+
+   bool operator<(const SkimEventKey &o) const
+   {
+     if (fRun != o.fRun)
+       return fRun < o.fRun;
+     if (fLumi != o.fLumi)
+       return fLumi < o.fLumi;
+     return fEvent < o.fEvent;
+   }
+   bool operator==(const SkimEventKey &o) const
+   {
+     return fRun == o.fRun && fLumi == o.fLumi && fEvent == o.fEvent;
+   }
+   bool operator!=(const SkimEventKey &o) const { return !(*this == o); }
+};
+
+// Entries [fFirst, fFirst + fN) of the tree have key fKey
+struct SkimEventRange {
+   SkimEventKey fKey;
+   Long64_t     fFirst;
+   Long64_t     fN;
+};
+
+class SkimEventIndex {
+public :
+   SkimEventIndex() : fEntries(0) { }
+   virtual ~SkimEventIndex() { }
+
+   // Reads the key branches of every entry of tree, returns the number
+   // of records (-1 on error). lumi may be empty for trees without it,
+   // the key then has lumi 0.
+   Long64_t Build(TTree *tree, const char *run = "run", const char *lumi = "lumi", const char *event = "event");
+
+   Bool_t   Write(const char *file) const;
+   Bool_t   Read(const char *file);
+
+   // Every record of key, in entry order, kFALSE if none
+   Bool_t   Find(UInt_t run, UInt_t lumi, ULong64_t event, std::vector<SkimEventRange> &ranges) const;
+   // Same for tuples without lumi: every lumi section of run
+   Bool_t   Find(UInt_t run, ULong64_t event, std::vector<SkimEventRange> &ranges) const;
+
+   // Records in key order, for merge joins
+   Long64_t GetN() const { return (Long64_t) fRanges.size(); }
+   const SkimEventRange &At(Long64_t i) const { return fRanges[i]; }
+
+   // Entries of the indexed tree, to spot a stale index
+   Long64_t GetEntries() const { return fEntries; }
+
+   // Builds and writes the index of treeName in file, returns the
+   // number of records (-1 on error)
+   static Long64_t Index(const char *file, const char *treeName,
+                         const char *run = "run", const char *lumi = "lumi", const char *event = "event");
+   static TString  IndexName(const char *file);
+
+private :
+   Long64_t                     fEntries;
+   std::vector<SkimEventRange>  fRanges;   // sorted by fKey, then fFirst
+};
+
+#endif
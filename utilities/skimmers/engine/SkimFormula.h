@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////
+// SkimFormula: a cut given as text at run time, e.g.
+//
+//   lowMuon_pt >= 2.0 && abs(dimuonditrk_cosAlpha) > 0.90
+//
+// parsed once into a small stack bytecode whose variables are
+// bound to selection columns of a SkimSchema, so changing a
+// threshold needs neither ACLiC nor a restart. Evaluate() runs
+// the bytecode over a whole block (one loop per instruction on
+// arrays of the block size), Eval() on the current entry.
+//
+// Operators, by increasing precedence:
+//   ||   &&   == != < <= > >=   + -   * /   unary - !
+// Functions: abs(x), sqrt(x). Names are input branch names.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimFormula_h
+#define SkimFormula_h
+
+#include <TString.h>
+
+#include <vector>
+
+#include "SkimSchema.h"
+
+class SkimFormula {
+public :
+   SkimFormula() : fDepth(0), fPos(0), fStack(0), fSchema(0) { }
+   virtual ~SkimFormula() { }
+
+   // Parses expression, binding its names to schema selection columns
+   Bool_t   Compile(const char *expression, SkimSchema &schema);
+   const char *GetTitle() const { return fExpression.Data(); }
+
+   // mask[i] &= (formula != 0) for the block loaded by schema.LoadCuts()
+   void     Evaluate(const SkimSchema &schema, UChar_t *mask);
+
+   // values[i] = formula for the block loaded by schema.LoadCuts()
+   void     Values(const SkimSchema &schema, Double_t *values);
+
+   // Value on the current entry
+   Double_t Eval(const SkimSchema &schema) const;
+
+private :
+   enum EOp {
+     kColumn, kConst,
+     kAdd, kSub, kMul, kDiv, kNeg, kNot, kAbs, kSqrt,
+     kGreater, kGreaterEqual, kLess, kLessEqual, kEqual, kNotEqual,
+     kAnd, kOr
+   };
+
+   struct Instr {
+     EOp      fOp;
+     Int_t    fCut;     // kColumn: cut index in the schema
+     Double_t fValue;   // kConst
+   };
+
+   // Recursive descent, one level per precedence
+   Bool_t   ParseOr();
+   Bool_t   ParseAnd();
+   Bool_t   ParseCompare();
+   Bool_t   ParseSum();
+   Bool_t   ParseProduct();
+   Bool_t   ParseUnary();
+   Bool_t   ParsePrimary();
+   Bool_t   Accept(const char *token);
+   void     SkipSpaces();
+   void     Emit(EOp op, Int_t cut = -1, Double_t value = 0);
+   Bool_t   Fail(const char *what);
+
+   // Runs fCode over the block, returns the result row of fBlock
+   const Double_t *Run(const SkimSchema &schema);
+
+   TString              fExpression;
+   std::vector<Instr>   fCode;
+   Int_t                fDepth;    // stack depth needed by fCode
+
+   static const Int_t   kMaxDepth = 64;
+
+   // Parsing state
+   Int_t                fPos;
+   Int_t                fStack;
+   SkimSchema          *fSchema;
+
+   // Block evaluation stack, [depth][entry]
+   std::vector<Double_t> fBlock;
+};
+
+#endif
@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////
+// SkimMassKernels: invariant masses of 2 to 6 body combinations
+// for a whole batch of candidates per call.
+//
+// Every particle of the combination is a SkimMassInput: the px,
+// py, pz arrays of the batch (structure of arrays, one value per
+// candidate) and either a mass hypothesis, from which the energy
+// is computed, or an energy array (e.g. refitted four-vectors or
+// a composite such as the dimuon). The candidates go in chunks:
+// every input is added to the energy and momentum sums of the
+// chunk in one pass, then the masses of the chunk are taken, so the
+// hypothesis/energy choice is made once per input and chunk and
+// never inside the candidate loops. Those loops are written with
+// SSE2 intrinsics (two candidates per instruction, in double
+// precision as TLorentzVector), part of every x86-64 target, so
+// they do not depend on the compiler vectorizing them under the
+// ACLiC flags (which it does not: sqrt() sets errno); elsewhere
+// they are plain loops. There are no TLorentzVector temporaries.
+//
+//   SkimMassInput in[4] = { SkimMassInput(mu1Px, mu1Py, mu1Pz, kSkimMuonMass), ... };
+//   SkimMass::Quadruplet(in, nX, xMass);
+//////////////////////////////////////////////////////////
+
+#ifndef SkimMassKernels_h
+#define SkimMassKernels_h
+
+#include <Rtypes.h>
+
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// PDG masses (GeV) of the track hypotheses
+const Double_t kSkimMuonMass   = 0.1056583745;
+const Double_t kSkimPionMass   = 0.13957018;
+const Double_t kSkimKaonMass   = 0.493677;
+const Double_t kSkimProtonMass = 0.938272046;
+
+struct SkimMassInput {
+   const Float_t *fPx;
+   const Float_t *fPy;
+   const Float_t *fPz;
+   const Float_t *fE;     // 0: energy from fMass
+   Double_t       fMass;
+
+   SkimMassInput() : fPx(0), fPy(0), fPz(0), fE(0), fMass(0) { }
+   SkimMassInput(const Float_t *px, const Float_t *py, const Float_t *pz, Double_t mass)
+     : fPx(px), fPy(py), fPz(pz), fE(0), fMass(mass) { }
+   SkimMassInput(const Float_t *px, const Float_t *py, const Float_t *pz, const Float_t *e)
+     : fPx(px), fPy(py), fPz(pz), fE(e), fMass(0) { }
+};
+
+class SkimMass {
+public :
+   // out[i] = mass of the sum of the N inputs for candidate i, with the
+   // TLorentzVector::M() convention (negative for space-like sums)
+   template <Int_t N>
+   static void Compute(const SkimMassInput *in, Int_t n, Float_t *out)
+   {
+     Double_t e[kChunk], px[kChunk], py[kChunk], pz[kChunk];
+     for (Int_t first = 0; first < n; first += kChunk)
+     {
+       Int_t m = n - first < kChunk ? n - first : kChunk;
+       for (Int_t i = 0; i < m; ++i)
+         e[i] = px[i] = py[i] = pz[i] = 0;
+       for (Int_t k = 0; k < N; ++k)
+         Add(in[k], first, m, e, px, py, pz);
+       Masses(e, px, py, pz, m, out + first);
+     }
+   }
+
+   static void Pair(const SkimMassInput *in, Int_t n, Float_t *out)       { Compute<2>(in, n, out); }
+   static void Triplet(const SkimMassInput *in, Int_t n, Float_t *out)    { Compute<3>(in, n, out); }
+   static void Quadruplet(const SkimMassInput *in, Int_t n, Float_t *out) { Compute<4>(in, n, out); }
+   static void Five(const SkimMassInput *in, Int_t n, Float_t *out)       { Compute<5>(in, n, out); }
+   static void Six(const SkimMassInput *in, Int_t n, Float_t *out)        { Compute<6>(in, n, out); }
+
+   // nIn from 1 to 6 known at run time
+   static Bool_t Compute(const SkimMassInput *in, Int_t nIn, Int_t n, Float_t *out)
+   {
+     switch (nIn)
+     {
+       case 1: Compute<1>(in, n, out); return kTRUE;
+       case 2: Compute<2>(in, n, out); return kTRUE;
+       case 3: Compute<3>(in, n, out); return kTRUE;
+       case 4: Compute<4>(in, n, out); return kTRUE;
+       case 5: Compute<5>(in, n, out); return kTRUE;
+       case 6: Compute<6>(in, n, out); return kTRUE;
+       default: return kFALSE;
+     }
+   }
+
+private :
+   // Candidates per chunk, the sums stay in L1
+   static const Int_t kChunk = 256;
+
+#if defined(__SSE2__)
+   // Two Float_t at p, as doubles
+   static __m128d Load2(const Float_t *p)
+   {
+     return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *) p)));
+   }
+#endif
+
+   // Adds candidates [first, first + m) of in to the sums
+   static void Add(const SkimMassInput &in, Int_t first, Int_t m, Double_t *e, Double_t *px, Double_t *py, Double_t *pz)
+   {
+     const Float_t *x = in.fPx + first, *y = in.fPy + first, *z = in.fPz + first;
+     const Float_t *energy = in.fE ? in.fE + first : 0;
+     Double_t m2 = in.fMass * in.fMass;
+     Int_t i = 0;
+#if defined(__SSE2__)
+     __m128d vm2 = _mm_set1_pd(m2);
+     for (; i + 2 <= m; i += 2)
+     {
+       __m128d vx = Load2(x + i), vy = Load2(y + i), vz = Load2(z + i);
+       __m128d ve = energy ? Load2(energy + i)
+                           : _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)),
+                                                               _mm_mul_pd(vz, vz)), vm2));
+       _mm_storeu_pd(e + i, _mm_add_pd(_mm_loadu_pd(e + i), ve));
+       _mm_storeu_pd(px + i, _mm_add_pd(_mm_loadu_pd(px + i), vx));
+       _mm_storeu_pd(py + i, _mm_add_pd(_mm_loadu_pd(py + i), vy));
+       _mm_storeu_pd(pz + i, _mm_add_pd(_mm_loadu_pd(pz + i), vz));
+     }
+#endif
+     for (; i < m; ++i)
+     {
+       Double_t vx = x[i], vy = y[i], vz = z[i];
+       e[i] += energy ? (Double_t) energy[i] : std::sqrt(vx * vx + vy * vy + vz * vz + m2);
+       px[i] += vx;
+       py[i] += vy;
+       pz[i] += vz;
+     }
+   }
+
+   // out[i] from the sums, negative for space-like ones
+   static void Masses(const Double_t *e, const Double_t *px, const Double_t *py, const Double_t *pz, Int_t m, Float_t *out)
+   {
+     Int_t i = 0;
+#if defined(__SSE2__)
+     const __m128d sign = _mm_set1_pd(-0.0);
+     for (; i + 2 <= m; i += 2)
+     {
+       __m128d ve = _mm_loadu_pd(e + i), vx = _mm_loadu_pd(px + i), vy = _mm_loadu_pd(py + i), vz = _mm_loadu_pd(pz + i);
+       __m128d mass2 = _mm_sub_pd(_mm_sub_pd(_mm_sub_pd(_mm_mul_pd(ve, ve), _mm_mul_pd(vx, vx)), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz));
+       __m128d mass = _mm_or_pd(_mm_sqrt_pd(_mm_andnot_pd(sign, mass2)), _mm_and_pd(sign, mass2));
+       _mm_storel_pi((__m64 *) (out + i), _mm_cvtpd_ps(mass));
+     }
+#endif
+     for (; i < m; ++i)
+     {
+       Double_t mass2 = e[i] * e[i] - px[i] * px[i] - py[i] * py[i] - pz[i] * pz[i];
+       out[i] = mass2 >= 0 ? std::sqrt(mass2) : -std::sqrt(-mass2);
+     }
+   }
+};
+
+#endif
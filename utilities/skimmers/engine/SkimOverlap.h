@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////
+// SkimOverlap: overlap of skims of the same data under different
+// mass hypotheses (2mu2k, 2mukpi, 2mupik), e.g. to veto the
+// reflections of one channel in another.
+//
+// Every input row gets a key, (run, event), sorted externally: each
+// input is read in chunks bounded by the memory budget, one thread
+// per input, every chunk is sorted and spilled to a temporary file,
+// and the spilled runs are merged. Only one buffer per run is in
+// memory during the merge.
+//
+// With track columns (momenta) the rows of an event are then matched
+// into candidates: two rows are the same candidate when their track
+// values, sorted (the kaon of one skim is the pion of another), all
+// agree within the resolution, and the candidate is every row linked
+// to another that way. There is no rounding: values a hair apart
+// always match, however they fall with respect to the resolution.
+//
+//   SkimOverlap join;
+//   join.Add("2mu2k_tree.root",  "outuple", "2mu2k");
+//   join.Add("2mukpi_tree.root", "outuple", "2mukpi");
+//   join.Add("2mupik_tree.root", "outuple", "2mupik");
+//   join.SetTrackKeys("muonp_pT:muonn_pT:kaonp_pT:kaonn_pT", 1e-3);
+//   join.Process("overlap.root");
+//
+// The output tree "SkimOverlap" has one row per event, or per
+// candidate with track columns, in (run, event) order: run, event,
+// tracks (the candidate in the event, from 1 in the order of its
+// track values, 0 for event keys), overlap (bit k set if input k has
+// the event or candidate, i.e. the overlap class) and per input
+// n_<label> (its rows) and entry_<label> (first of them, -1 if
+// none). The number per class is printed at the end.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimOverlap_h
+#define SkimOverlap_h
+
+#include <TString.h>
+
+#include <vector>
+
+class SkimOverlap {
+public :
+   SkimOverlap() : fRunName("run"), fEventName("evt"), fResolution(1e-3), fMaxMemory(512 << 20) { }
+   virtual ~SkimOverlap() { }
+
+   // label names the columns of the input in the output, at most 32 inputs
+   void     Add(const char *file, const char *treeName, const char *label);
+
+   // Key branches, float columns are rounded
+   void     SetKeys(const char *run, const char *event) { fRunName = run; fEventName = event; }
+
+   // ':' separated track momentum columns (at most kMaxTracks) matching
+   // the rows of an event within resolution (empty: event level overlap)
+   Bool_t   SetTrackKeys(const char *columns, Double_t resolution = 1e-3);
+
+   static const Int_t kMaxTracks = 8;
+
+   // Bytes of keys held in memory while sorting, all inputs together
+   void     SetMaxMemory(Long64_t bytes) { fMaxMemory = bytes; }
+
+   // Returns the number of keys written (-1 on error)
+   Long64_t Process(const char *output);
+
+private :
+   struct Input {
+     TString fFile;
+     TString fTreeName;
+     TString fLabel;
+   };
+
+   // One input row, ordered by (run, event), then input and entry
+   struct Record {
+     UInt_t    fRun;
+     UInt_t    fInput;
+     ULong64_t fEvent;
+     Long64_t  fEntry;
+     Float_t   fTracks[kMaxTracks];  // sorted, 0 when unused
+
+     bool SameEvent(const Record &o) const { return fRun == o.fRun && fEvent == o.fEvent; }
+     bool operator<(const Record &o) const
+     {
+       if (fRun != o.fRun)
+         return fRun < o.fRun;
+       if (fEvent != o.fEvent)
+         return fEvent < o.fEvent;
+       if (fInput != o.fInput)
+         return fInput < o.fInput;
+       return fEntry < o.fEntry;
+     }
+   };
+
+   // Reads, sorts and spills input in chunks of maxRecords, adds the
+   // spilled files to runs
+   Bool_t   SortInput(Int_t input, Long64_t maxRecords, const char *output, std::vector<TString> &runs) const;
+   Bool_t   Spill(std::vector<Record> &chunk, const TString &name) const;
+   // Candidate of every row of an event (from 0, in track order),
+   // returns the number of candidates
+   Int_t    Match(const std::vector<Record> &event, std::vector<Int_t> &candidate) const;
+
+   std::vector<Input>    fInputs;
+   TString               fRunName;
+   TString               fEventName;
+   std::vector<TString>  fTrackNames;
+   Double_t              fResolution;
+   Long64_t              fMaxMemory;
+};
+
+#endif
@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////
+// SkimP4: four-vector as four floats (pt, eta, phi, m), the
+// layout of the kSkimPtEtaPhiM output columns.
+//
+// A plain value type: no TObject, no streamer, 16 bytes. It is
+// what a compact column reads back into, e.g.
+//
+//   SkimP4 six(six_p4_pt, six_p4_eta, six_p4_phi, six_p4_m);
+//   if (six.M() > 5.0 && lowMuon.DeltaR(highMuon) < 1.0) ...
+//
+// Sums go through (px, py, pz, E) in double precision.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimP4_h
+#define SkimP4_h
+
+#include <Rtypes.h>
+#include <TLorentzVector.h>
+
+#include <cmath>
+
+struct SkimP4 {
+   Float_t fPt;
+   Float_t fEta;
+   Float_t fPhi;
+   Float_t fM;
+
+   SkimP4() : fPt(0), fEta(0), fPhi(0), fM(0) { }
+   SkimP4(Float_t pt, Float_t eta, Float_t phi, Float_t m) : fPt(pt), fEta(eta), fPhi(phi), fM(m) { }
+   explicit SkimP4(const TLorentzVector &v) { SetPxPyPzE(v.Px(), v.Py(), v.Pz(), v.E()); }
+
+   // Same conventions as TLorentzVector: eta = +-1e10 along the beam,
+   // negative m for space-like vectors
+   void SetPxPyPzE(Double_t px, Double_t py, Double_t pz, Double_t e)
+   {
+     Double_t pt = std::sqrt(px * px + py * py);
+     Double_t m2 = e * e - px * px - py * py - pz * pz;
+     fPt = pt;
+     fEta = pt > 0 ? std::asinh(pz / pt) : (pz >= 0 ? 1e10 : -1e10);
+     fPhi = pt > 0 ? std::atan2(py, px) : 0;
+     fM = m2 >= 0 ? std::sqrt(m2) : -std::sqrt(-m2);
+   }
+
+   Double_t Pt() const  { return fPt; }
+   Double_t Eta() const { return fEta; }
+   Double_t Phi() const { return fPhi; }
+   Double_t M() const   { return fM; }
+
+   Double_t Px() const  { return fPt * std::cos(fPhi); }
+   Double_t Py() const  { return fPt * std::sin(fPhi); }
+   Double_t Pz() const  { return fPt * std::sinh(fEta); }
+   Double_t P() const   { return fPt * std::cosh(fEta); }
+   Double_t E() const
+   {
+     Double_t p = P();
+     return fM >= 0 ? std::sqrt(p * p + fM * fM) : std::sqrt(p * p - fM * fM);
+   }
+
+   Double_t DeltaPhi(const SkimP4 &o) const
+   {
+     Double_t d = fPhi - o.fPhi;
+     while (d > M_PI)
+       d -= 2 * M_PI;
+     while (d <= -M_PI)
+       d += 2 * M_PI;
+     return d;
+   }
+
+   Double_t DeltaR(const SkimP4 &o) const
+   {
+     Double_t deta = fEta - o.fEta;
+     Double_t dphi = DeltaPhi(o);
+     return std::sqrt(deta * deta + dphi * dphi);
+   }
+
+   SkimP4 operator+(const SkimP4 &o) const
+   {
+     SkimP4 sum;
+     sum.SetPxPyPzE(Px() + o.Px(), Py() + o.Py(), Pz() + o.Pz(), E() + o.E());
+     return sum;
+   }
+
+   TLorentzVector ToLorentzVector() const
+   {
+     TLorentzVector v;
+     v.SetPtEtaPhiM(fPt, fEta, fPhi, fM);
+     return v;
+   }
+};
+
+#endif
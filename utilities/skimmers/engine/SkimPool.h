@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////
+// SkimPool: a small work-stealing thread pool.
+//
+// Tasks are plain integers (the index of a SkimUnit). Each worker
+// owns a queue and drains it from the front, so it stays on the
+// same input file as long as possible; a worker whose queue is
+// empty steals from the back of the other queues, i.e. from the
+// part of the other workers' share they would reach last.
+// GetNStolen() tells how many tasks a worker took from the others.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimPool_h
+#define SkimPool_h
+
+#include <Rtypes.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SkimPool {
+public :
+   SkimPool(Int_t nWorkers)
+   {
+     for (Int_t i = 0; i < nWorkers; ++i)
+       fQueues.emplace_back(new Queue());
+   }
+
+   Int_t GetNWorkers() const { return (Int_t) fQueues.size(); }
+
+   void Push(Int_t worker, Int_t task)
+   {
+     std::lock_guard<std::mutex> lock(fQueues[worker]->fMutex);
+     fQueues[worker]->fTasks.push_back(task);
+   }
+
+   // Next task for worker, kFALSE once every queue is empty
+   Bool_t Next(Int_t worker, Int_t &task)
+   {
+     {
+       Queue &own = *fQueues[worker];
+       std::lock_guard<std::mutex> lock(own.fMutex);
+       if (!own.fTasks.empty())
+       {
+         task = own.fTasks.front();
+         own.fTasks.pop_front();
+         return kTRUE;
+       }
+     }
+
+     Int_t n = GetNWorkers();
+     for (Int_t i = 1; i < n; ++i)
+     {
+       Queue &victim = *fQueues[(worker + i) % n];
+       std::lock_guard<std::mutex> lock(victim.fMutex);
+       if (!victim.fTasks.empty())
+       {
+         task = victim.fTasks.back();
+         victim.fTasks.pop_back();
+         // Only the thief writes its own count
+         ++fQueues[worker]->fStolen;
+         return kTRUE;
+       }
+     }
+     return kFALSE;
+   }
+
+   // k-th task waiting in the own queue of worker, without taking it
+   Bool_t Peek(Int_t worker, Int_t k, Int_t &task)
+   {
+     Queue &own = *fQueues[worker];
+     std::lock_guard<std::mutex> lock(own.fMutex);
+     if (k >= (Int_t) own.fTasks.size())
+       return kFALSE;
+     task = own.fTasks[k];
+     return kTRUE;
+   }
+
+   Int_t GetNStolen(Int_t worker) const { return fQueues[worker]->fStolen; }
+
+   // Runs work(worker) on one thread per worker and waits for all of them
+   void Run(const std::function<void(Int_t)> &work)
+   {
+     std::vector<std::thread> threads;
+     for (Int_t i = 0; i < GetNWorkers(); ++i)
+       threads.emplace_back(work, i);
+     for (auto &t : threads)
+       t.join();
+   }
+
+private :
+   struct Queue {
+     Queue() : fStolen(0) { }
+     std::mutex         fMutex;
+     std::deque<Int_t>  fTasks;
+     Int_t              fStolen;
+   };
+
+   std::vector<std::unique_ptr<Queue> > fQueues;
+};
+
+#endif
@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////
+// SkimReadAhead: input side of a SkimEngine worker.
+//
+// Without it a worker alternates between waiting for its basket
+// reads from lustre and decompressing/selecting them. With it the
+// work is split in three stages that overlap:
+//
+//  - read-ahead: a thread per worker that, while the worker is on
+//    one unit, prepares the next ones starting a new input file
+//    (among the units waiting in the worker queue): opens the file,
+//    points its tree cache at the unit and fills it with the first
+//    clusters, so the open and storage latency are paid before the
+//    worker gets there. The prepared file, tree and cache are handed
+//    over to the worker (Take()), nothing is read twice. Units in
+//    the file the worker has open are not prepared: the worker
+//    keeps its file and tree and only moves the cache range, which
+//    reads ahead within the file by itself;
+//  - cache: the tree cache is set to the entry range of the unit
+//    with the branches read for every entry (the selection columns
+//    for SkimSchemaTopology, SkimTopology::GetRangeBranches()), in
+//    a few vectored reads of whole clusters; the other branches are
+//    read on demand, for the selected entries only;
+//  - unzip: the cache decompresses the baskets ahead of the entry
+//    being read on its own pool of threads (TTreeCacheUnzip), for
+//    the prepared units already while the worker is on the previous
+//    one.
+//
+// The queue between read-ahead and the worker is bounded by depth:
+// Request() returns kFALSE when it is full, the unit may be asked
+// for again later. Units stolen by another worker are dropped at the
+// next Take(), the worker opens and reads itself any unit it did not
+// get from the queue.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimReadAhead_h
+#define SkimReadAhead_h
+
+#include <TString.h>
+#include <TTree.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TFile;
+
+// One unit of work of an input, as read ahead
+struct SkimReadAheadUnit {
+  Int_t    fTask;
+  TString  fFile;
+  TString  fTreePath;
+  Long64_t fFirst;
+  Long64_t fLast;        // excluded
+  Bool_t   fToClusters;  // [fFirst, fLast) moved to cluster starts
+  Long64_t fInputFirst;  // entries of the input, the clusters are
+  Long64_t fInputEnd;    // not moved out of them
+};
+
+class SkimReadAhead {
+public :
+   SkimReadAhead(Int_t depth = 2, Long64_t cacheSize = 64 << 20, Bool_t parallelUnzip = kTRUE);
+   virtual ~SkimReadAhead();
+
+   // Branches cached for every unit, see SetRange()
+   void     SetBranches(const std::vector<TString> &branches);
+
+   // Queues unit, kFALSE when the queue is full
+   Bool_t   Request(const SkimReadAheadUnit &unit);
+
+   // The prepared file (owned by the caller from now on), tree and
+   // range of task; kFALSE when it was not queued or failed. Queued
+   // units other than the ones ahead (still waiting for the worker)
+   // are dropped, hit or miss.
+   Bool_t   Take(Int_t task, const std::vector<Int_t> &ahead, TFile *&file, TTree *&tree, Long64_t &first, Long64_t &last);
+
+   // Moves [first, last) to cluster starts when unit.fToClusters
+   static void     Align(TTree *tree, const SkimReadAheadUnit &unit, Long64_t &first, Long64_t &last);
+   // First cluster start from entry on, last if there is none before
+   static Long64_t ClusterStart(TTree *tree, Long64_t entry, Long64_t last);
+   // Points the tree cache of tree at [first, last) with branches,
+   // whose learning phase is stopped; none: ROOT learns them
+   static void     SetRange(TTree *tree, Long64_t first, Long64_t last, Long64_t cacheSize, Bool_t parallelUnzip,
+                            const std::vector<TString> &branches);
+
+   // Bytes read by the read-ahead thread
+   Long64_t GetBytesRead() const { return fBytesRead; }
+
+private :
+   enum EState { kPending, kReading, kReady, kFailed };
+
+   struct Entry {
+     SkimReadAheadUnit fUnit;
+     EState            fState;
+     Bool_t            fDropped;  // while kReading, deleted when read
+     TFile            *fFile;
+     TTree            *fTree;
+   };
+
+   void     Loop();
+   Bool_t   Prepare(Entry &entry, const std::vector<TString> &branches);
+
+   Int_t                    fDepth;
+   Long64_t                 fCacheSize;
+   Bool_t                   fParallelUnzip;
+   std::vector<TString>     fBranches;
+   std::list<Entry>         fQueue;
+   std::mutex               fMutex;
+   std::condition_variable  fWake;   // read-ahead thread
+   std::condition_variable  fReady;  // worker
+   Bool_t                   fStop;
+   std::atomic<Long64_t>    fBytesRead;
+   std::thread              fThread;
+};
+
+#endif
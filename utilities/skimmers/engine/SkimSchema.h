@@ -0,0 +1,168 @@
+//////////////////////////////////////////////////////////
+// SkimSchema: declarative branch list for a skim.
+//
+// A topology describes its columns once, as a table of
+//   { input name, input type, output name, output type }
+// and the schema takes care of what skimvars.sh and the pasted
+// vars/branches/assign files used to do by hand: the input
+// branch addresses, the output buffers, the outTree->Branch()
+// calls and the per-entry copy.
+//
+// Columns are grouped by (input type, output type) and every
+// group is stored contiguously, in the input and in the output
+// buffer, so the copy is one tight conversion loop per group
+// instead of one assignment per variable.
+//
+// Outputs keep their native type: run, event, lumi, trigger
+// words, hit counts and flags are written as integers/bools, not
+// as "/F" leaves. With kSkimAuto as output type the schema picks
+// the narrowest exact type, from the range the column declares
+// (fMin, fMax: hit counts, charges, bitmasks) or else from its
+// input type. A declared range also makes a floating point column
+// integer valued (the charges the ntuplizers store as doubles).
+//
+// Four-vectors can be written as TLorentzVector objects (kSkimP4)
+// or split into four float branches (kSkimPtEtaPhiM), which are
+// smaller and read back without a streamer.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimSchema_h
+#define SkimSchema_h
+
+#include <TTree.h>
+#include <TBranch.h>
+#include <TString.h>
+#include <TLorentzVector.h>
+
+#include <vector>
+
+enum ESkimType {
+  kSkimBool,
+  kSkimChar,
+  kSkimUChar,
+  kSkimShort,
+  kSkimUShort,
+  kSkimInt,
+  kSkimUInt,
+  kSkimLong64,
+  kSkimULong64,
+  kSkimFloat,
+  kSkimDouble,
+  kSkimP4,        // TLorentzVector object
+  kSkimPtEtaPhiM, // output only, a kSkimP4 as <name>_pt/_eta/_phi/_m floats (SkimP4.h)
+  kSkimAuto       // output only, see SkimSchema::Narrowest()
+};
+
+typedef void (*SkimConvertFn)(const void *in, void *out, Int_t n);
+
+struct SkimColumn {
+  const char *fIn;
+  ESkimType   fInType;
+  const char *fOut;
+  ESkimType   fOutType;
+  Long64_t    fMin;  // range of the integer values, for kSkimAuto;
+  Long64_t    fMax;  // none when equal (left out of the table: 0, 0)
+};
+
+class SkimSchema {
+public :
+   SkimSchema(const SkimColumn *columns, Int_t nColumns);
+   virtual ~SkimSchema();
+
+   // Output branches pointing into the packed output buffer
+   void     Book(TTree *outTree);
+
+   // Input branch addresses into the packed input buffer
+   Bool_t   Init(TTree *tree);
+
+   // Reads every column of entry
+   void     GetEntry(Long64_t entry);
+
+   // Two-phase reading. LoadCuts() reads only the selection columns
+   // for entries [first, last), one branch at a time so each of their
+   // baskets is decompressed once for the whole block, into one
+   // contiguous array per column (GetCutColumn()). SetCutEntry()
+   // puts the values of one entry of the block back at the Address()
+   // pointers and GetRestEntry() reads every other column, to be
+   // called only for entries passing the selection.
+   Long64_t LoadCuts(Long64_t first, Long64_t last);
+   void     SetCutEntry(Long64_t entry);
+   void     GetRestEntry(Long64_t entry);
+   // Input branches read for every entry of a range: the selection
+   // columns, every column when there is none
+   void     GetRangeBranches(std::vector<TString> &names) const;
+
+   // Marks a column as selection column, returns its cut index (-1 on error)
+   Int_t    AddCut(const char *inName);
+   Int_t    GetNCuts() const { return (Int_t) fCutColumns.size(); }
+   ESkimType   GetCutType(Int_t cut) const { return fColumns[fCutColumns[cut]].fInType; }
+   const void *GetCutColumn(Int_t cut) const { return &fCutBlock[cut * fCutStride]; }
+   const void *GetCutAddress(Int_t cut) const { return InAddress(fCutColumns[cut]); }
+   Long64_t GetBlockFirst() const { return fBlockFirst; }
+   Long64_t GetBlockSize() const  { return fBlockSize; }
+
+   // Converts the input buffer into the output buffer
+   void     Copy();
+
+   Int_t    GetNColumns() const { return (Int_t) fColumns.size(); }
+   Int_t    Find(const char *inName) const;
+
+   // Address of the input value of a column, stable for the
+   // lifetime of the schema, to be resolved once by the topology.
+   // For kSkimP4 columns T is TLorentzVector *.
+   template <typename T> const T *Address(const char *inName) const
+   {
+     Int_t i = Find(inName);
+     return i < 0 ? 0 : (const T *) InAddress(i);
+   }
+
+   // Same as Address() and marks the column as a selection column
+   template <typename T> const T *CutAddress(const char *inName)
+   {
+     Int_t i = Find(inName);
+     return i < 0 || MarkCut(i) < 0 ? 0 : (const T *) InAddress(i);
+   }
+
+   // Output type for kSkimAuto: the smallest integer type holding
+   // [min, max] when declared (values outside are not checked), else
+   // flags and integers keep their type and floating point goes to
+   // Float_t as the analysis always did
+   static ESkimType   Narrowest(ESkimType type, Long64_t min = 0, Long64_t max = 0);
+
+   static Int_t       SizeOf(ESkimType type);
+   static const char *LeafCode(ESkimType type);
+   static const char *TypeName(ESkimType type);
+
+private :
+   struct Group {
+     ESkimType fInType;
+     ESkimType fOutType;
+     Int_t     fInOffset;   // bytes into fIn, index into fInP4 for kSkimP4
+     Int_t     fOutOffset;  // bytes into fOut, index into fOutP4 for kSkimP4
+     Int_t     fN;
+     SkimConvertFn fConvert;
+   };
+
+   const void *InAddress(Int_t column) const;
+   void       *OutAddress(Int_t column);
+   Int_t       MarkCut(Int_t column);
+
+   std::vector<SkimColumn>        fColumns;
+   std::vector<Int_t>             fGroupOf;   // per column
+   std::vector<Int_t>             fSlot;      // per column, index inside its group
+   std::vector<Group>             fGroups;
+   std::vector<ULong64_t>         fIn;        // 8 byte aligned storage
+   std::vector<ULong64_t>         fOut;
+   std::vector<TLorentzVector *>  fInP4;      // kSkimP4 columns, allocated and owned by the input branches
+   std::vector<TLorentzVector *>  fOutP4;
+   std::vector<TBranch *>         fBranches;  // per column, 0 when missing
+
+   std::vector<Int_t>             fCutColumns;
+   std::vector<Int_t>             fRestColumns;
+   std::vector<ULong64_t>         fCutBlock;  // [cut][entry - fBlockFirst], native type
+   Long64_t                       fCutStride; // 8 byte words per cut column
+   Long64_t                       fBlockFirst;
+   Long64_t                       fBlockSize;
+};
+
+#endif
@@ -0,0 +1,198 @@
+//////////////////////////////////////////////////////////
+// SkimSchemaTopology: topology whose columns are all described
+// by a SkimSchema, the implementation only has to provide the
+// selection.
+//
+// Cuts of the form "column op value" go into fSelection (bound
+// with fSelection.Bind(fSchema) in the constructor) and are
+// evaluated a block at a time; whatever cannot be written that
+// way goes into Select(), called on the survivors with the
+// values of the selection columns. The other columns are only
+// read for the entries passing both.
+//
+// With cut variants (SetVariants()) the variants replace
+// fSelection: an entry is written when it passes at least one of
+// them, and the "cutVariants" branch has bit k set when it
+// passes variant k.
+//
+// With a SkimStats the cut-flow is the cuts of fSelection, in
+// order, then Select(), and every block is timed in three stages:
+// the selection columns (read), the cuts and Select() (select), the
+// other columns of the survivors with their copy and Fill() (copy).
+//////////////////////////////////////////////////////////
+
+#ifndef SkimSchemaTopology_h
+#define SkimSchemaTopology_h
+
+#include <vector>
+
+#include "SkimTopology.h"
+#include "SkimSchema.h"
+#include "SkimSelection.h"
+
+class SkimSchemaTopology : public SkimTopology {
+public :
+   SkimSchemaTopology(const char *treeName, const char *dirName, const char *outTreeName,
+                      const SkimColumn *columns, Int_t nColumns)
+     : SkimTopology(treeName, dirName, outTreeName), fSchema(columns, nColumns), fVariantBits(0) { }
+   virtual ~SkimSchemaTopology() { }
+
+   virtual void    Book(TTree *outTree)
+   {
+     fSchema.Book(outTree);
+     if (!fVariants.empty())
+       outTree->Branch("cutVariants", &fVariantBits, "cutVariants/i");
+   }
+   virtual void    Init(TTree *tree)    { fSchema.Init(tree); }
+   virtual Bool_t  Process(Long64_t entry)
+   {
+     fSchema.GetEntry(entry);
+     if (fVariants.empty())
+     {
+       if (!fSelection.Pass(fSchema))
+         return kFALSE;
+     }
+     else
+     {
+       fVariantBits = 0;
+       for (UInt_t v = 0; v < fVariants.size(); ++v)
+         if (fVariants[v].Pass(fSchema))
+           fVariantBits |= 1u << v;
+       if (!fVariantBits)
+         return kFALSE;
+     }
+     if (!Select())
+       return kFALSE;
+     fSchema.Copy();
+     return kTRUE;
+   }
+
+   // Two-phase loop when the topology has selection columns
+   // (fSelection, the variants or fSchema.CutAddress())
+   virtual Long64_t ProcessRange(Long64_t first, Long64_t last, TTree *outTree)
+   {
+     if (!fSchema.GetNCuts())
+       return SkimTopology::ProcessRange(first, last, outTree);
+
+     Long64_t *flow = fStats && fVariants.empty() && !fStats->fCutPass.empty() ? fStats->fCutPass.data() : 0;
+     SkimStats::Clock::time_point t;
+     if (fStats)
+       t = SkimStats::Clock::now();
+     Long64_t selected = 0;
+     for (Long64_t block = first; block < last; block += kBlockSize)
+     {
+       fSchema.LoadCuts(block, block + kBlockSize < last ? block + kBlockSize : last);
+       if (fStats)
+         t = fStats->Stamp(kSkimRead, t);
+       if (fVariants.empty())
+         fSelection.Evaluate(fSchema, fPass, flow);
+       else
+         EvaluateVariants();
+
+       // Select() on the survivors of the cuts, fPass keeps its own
+       UInt_t n = 0;
+       for (UInt_t k = 0; k < fPass.size(); ++k)
+       {
+         fSchema.SetCutEntry(block + fPass[k]);
+         if (Select())
+           fPass[n++] = fPass[k];
+       }
+       fPass.resize(n);
+       if (flow)
+         flow[fStats->fCutPass.size() - 1] += n;
+       if (fStats)
+         t = fStats->Stamp(kSkimSelect, t);
+
+       for (UInt_t k = 0; k < n; ++k)
+       {
+         Long64_t entry = block + fPass[k];
+         fSchema.SetCutEntry(entry);
+         if (!fVariants.empty())
+           fVariantBits = fBits[fPass[k]];
+         fSchema.GetRestEntry(entry);
+         fSchema.Copy();
+         outTree->Fill();
+       }
+       selected += n;
+       if (fStats)
+         t = fStats->Stamp(kSkimCopy, t);
+     }
+     return selected;
+   }
+
+   // The selection columns, read a block at a time; the others are
+   // read for the survivors only and stay out of the cache
+   virtual void    GetRangeBranches(std::vector<TString> &names) const { fSchema.GetRangeBranches(names); }
+
+   virtual void    SetStats(SkimStats *stats)
+   {
+     SkimTopology::SetStats(stats);
+     if (!stats)
+       return;
+     std::vector<TString> names;
+     if (fVariants.empty())
+     {
+       for (Int_t k = 0; k < fSelection.GetNCuts(); ++k)
+         names.push_back(fSelection.GetCutName(k));
+       names.push_back("Select()");
+     }
+     stats->SetCuts(names);
+   }
+
+   // Run time cuts replace fSelection, Select() still applies. The
+   // columns of the replaced cuts are still read in the first phase.
+   virtual Bool_t  SetCuts(const char *cuts)
+   {
+     fSelection.Clear();
+     if (fSelection.ReadCuts(cuts) < 0)
+       return kFALSE;
+     return fSelection.Bind(fSchema);
+   }
+
+   virtual Bool_t  SetVariants(const std::vector<TString> &cuts)
+   {
+     if (cuts.size() > 32)
+     {
+       ::Error("SkimSchemaTopology::SetVariants", "At most 32 variants, got %d", (Int_t) cuts.size());
+       return kFALSE;
+     }
+     fVariants.assign(cuts.size(), SkimSelection());
+     for (UInt_t v = 0; v < cuts.size(); ++v)
+       if (fVariants[v].ReadCuts(cuts[v]) < 0 || !fVariants[v].Bind(fSchema))
+         return kFALSE;
+     return kTRUE;
+   }
+
+   // Rest of the selection on the current entry, values from
+   // fSchema.CutAddress()
+   virtual Bool_t  Select() { return kTRUE; }
+
+protected :
+   static const Long64_t kBlockSize = 4096;
+
+   // Variant bits of the block into fBits, survivors of any into fPass
+   void EvaluateVariants()
+   {
+     Int_t n = (Int_t) fSchema.GetBlockSize();
+     fBits.assign(n, 0);
+     for (UInt_t v = 0; v < fVariants.size(); ++v)
+     {
+       const UChar_t *mask = fVariants[v].Mask(fSchema);
+       for (Int_t i = 0; i < n; ++i)
+         fBits[i] |= (UInt_t) mask[i] << v;
+     }
+     fPass.clear();
+     for (Int_t i = 0; i < n; ++i)
+       if (fBits[i])
+         fPass.push_back(i);
+   }
+
+   SkimSchema                  fSchema;
+   SkimSelection               fSelection;
+   std::vector<SkimSelection>  fVariants;
+   std::vector<Int_t>          fPass;        // survivors of the current block
+   std::vector<UInt_t>         fBits;        // variant bits of the current block
+   UInt_t                      fVariantBits; // "cutVariants" of the current entry
+};
+
+#endif
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////
+// SkimSelection: the "bool test = test && ..." chains of the
+// skimmers as a list of cuts evaluated a block at a time.
+//
+// Each cut is "column op value" (or "|column| op value") on a
+// selection column of a SkimSchema. Evaluate() runs every cut as
+// one branch-free loop over the contiguous column the schema
+// loaded for the block, and-ing into a byte mask, so the compiler
+// can vectorize it, then returns the offsets of the surviving
+// entries: only those go on to the copy stage.
+//
+//   fSelection.Add("dimuonditrk_vProb", kSkimGreater, 0.015);
+//   fSelection.Add("dimuonditrk_cosAlpha", kSkimGreater, 0.90, kTRUE);
+//
+// Anything else is written as a SkimFormula expression, also given
+// at run time as a list (ReadCuts()) to scan cut variants without
+// recompiling the topology.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimSelection_h
+#define SkimSelection_h
+
+#include <TString.h>
+
+#include <vector>
+
+#include "SkimSchema.h"
+#include "SkimFormula.h"
+
+enum ESkimCut {
+  kSkimGreater,
+  kSkimGreaterEqual,
+  kSkimLess,
+  kSkimLessEqual,
+  kSkimEqual,
+  kSkimNotEqual
+};
+
+class SkimSelection {
+public :
+   SkimSelection() { }
+   virtual ~SkimSelection() { }
+
+   // Cuts are and-ed, abs compares |column|
+   void     Add(const char *column, ESkimCut op, Double_t value, Bool_t abs = kFALSE);
+   void     Add(const char *expression);
+   // Cuts Mask() applies, and counts in its flow: the expressions are
+   // only there once bound
+   Int_t    GetNCuts() const { return (Int_t) (fCuts.size() + fFormulas.size()); }
+   // k-th of them as written
+   TString  GetCutName(Int_t k) const;
+   void     Clear();
+
+   // Adds one expression per line of file cuts, or per ';' separated
+   // item when cuts is not a file. Blank lines and '#' comments are
+   // skipped. Returns the number of expressions, -1 on error.
+   Int_t    ReadCuts(const char *cuts);
+
+   // Declares the columns of the cuts as selection columns of schema
+   // and compiles the expressions
+   Bool_t   Bind(SkimSchema &schema);
+
+   // Block at a time, on the columns loaded by schema.LoadCuts():
+   // fills pass with the offsets (entry - first) of the passing entries.
+   // With flow, flow[k] is incremented by the entries of the block
+   // passing the first k + 1 cuts (GetNCuts() counters).
+   Int_t    Evaluate(const SkimSchema &schema, std::vector<Int_t> &pass, Long64_t *flow = 0);
+
+   // Same, as one byte per entry of the block (1 when passing)
+   const UChar_t *Mask(const SkimSchema &schema, Long64_t *flow = 0);
+
+   // One entry, on the values at the schema Address() pointers
+   Bool_t   Pass(const SkimSchema &schema) const;
+
+private :
+   struct Cut {
+     TString  fColumn;
+     ESkimCut fOp;
+     Double_t fValue;
+     Bool_t   fAbs;
+     Int_t    fCut;     // cut index in the schema, -1 until bound
+   };
+
+   std::vector<Cut>         fCuts;
+   std::vector<TString>     fExpressions;
+   std::vector<SkimFormula> fFormulas;   // compiled fExpressions
+   std::vector<UChar_t>     fMask;
+};
+
+#endif
@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////
+// SkimStats: per-stage counters of a SkimEngine worker.
+//
+// Every worker counts the entries it reads and selects and the bytes
+// read from the input files. With SkimEngine::SetStageStats() (the
+// default) it also passes its SkimStats to its topology clone
+// (SkimTopology::SetStats()), which adds the time spent in each stage
+// of its loop, stamped once per unit or block, and, for the schema
+// topologies, the entries left after each cut of the selection (the
+// cut-flow). The engine sums the workers in a line printed every few
+// seconds while the skim runs and writes the totals to
+// <output>_stats.json at the end.
+//
+// Stages:
+//   open    opening the input files, Init() of the topology
+//   read    loading the selection columns, basket reads and
+//           unzipping included (the tree cache unzips on its own
+//           threads, a worker only waits for what is not unzipped)
+//   select  cuts and Select(); the whole loop for topologies
+//           without selection columns
+//   copy    other columns of the selected entries, their copy into
+//           the output buffers and TTree::Fill()
+//   write   output flushes (merger buffers, pieces)
+//////////////////////////////////////////////////////////
+
+#ifndef SkimStats_h
+#define SkimStats_h
+
+#include <TString.h>
+
+#include <chrono>
+#include <vector>
+
+enum ESkimStage {
+  kSkimOpen,
+  kSkimRead,
+  kSkimSelect,
+  kSkimCopy,
+  kSkimWrite,
+  kSkimNStages
+};
+
+struct SkimStats {
+   typedef std::chrono::steady_clock Clock;
+
+   SkimStats() { Clear(); }
+
+   void Clear()
+   {
+     fBytesRead = fBytesUnzipped = fBytesAhead = fEntries = fSelected = 0;
+     for (Int_t s = 0; s < kSkimNStages; ++s)
+       fTime[s] = 0;
+     fCutPass.assign(fCutNames.size(), 0);
+   }
+
+   // Names of the cut-flow steps, in the order they are applied
+   void SetCuts(const std::vector<TString> &names)
+   {
+     fCutNames = names;
+     fCutPass.assign(names.size(), 0);
+   }
+
+   // Adds the time since start to stage, returns the time now
+   Clock::time_point Stamp(Int_t stage, const Clock::time_point &start)
+   {
+     Clock::time_point now = Clock::now();
+     fTime[stage] += std::chrono::duration<Double_t>(now - start).count();
+     return now;
+   }
+
+   void Add(const SkimStats &other)
+   {
+     fBytesRead += other.fBytesRead;
+     fBytesUnzipped += other.fBytesUnzipped;
+     fBytesAhead += other.fBytesAhead;
+     fEntries += other.fEntries;
+     fSelected += other.fSelected;
+     for (Int_t s = 0; s < kSkimNStages; ++s)
+       fTime[s] += other.fTime[s];
+     if (fCutNames.empty())
+       SetCuts(other.fCutNames);
+     for (UInt_t k = 0; k < fCutPass.size() && k < other.fCutPass.size(); ++k)
+       fCutPass[k] += other.fCutPass[k];
+   }
+
+   static const char *StageName(Int_t stage)
+   {
+     static const char *names[kSkimNStages] = { "open", "read", "select", "copy", "write" };
+     return names[stage];
+   }
+
+   // Progress line after elapsed seconds
+   TString Line(Double_t elapsed) const
+   {
+     Double_t rate = elapsed > 0 ? 1 / elapsed : 0;
+     return TString::Format("[%6.0f s] %.3g M entries %.1f kHz, read %.3g GB %.1f MB/s (unzipped %.3g GB), selected %lld (%.3g %%)",
+                            elapsed, fEntries / 1e6, fEntries * rate / 1e3, fBytesRead / 1e9, fBytesRead * rate / 1e6,
+                            fBytesUnzipped / 1e9, fSelected, fEntries ? 100. * fSelected / fEntries : 0.);
+   }
+
+   // JSON string literal of s
+   static TString Quote(const char *s)
+   {
+     TString quoted = "\"";
+     for (const char *c = s; *c; ++c)
+     {
+       if (*c == '"' || *c == '\\')
+         quoted += '\\';
+       if ((UChar_t) *c < 0x20)
+         quoted += TString::Format("\\u%04x", (UInt_t) (UChar_t) *c);
+       else
+         quoted += *c;
+     }
+     return quoted + "\"";
+   }
+
+   Long64_t fBytesRead;      // compressed bytes read from the input files
+   Long64_t fBytesUnzipped;  // same, uncompressed (from the tree compression ratio)
+   Long64_t fBytesAhead;     // bytes prefetched by the read-ahead threads, of the
+                             // units taken counted in fBytesRead too
+   Long64_t fEntries;        // input entries processed
+   Long64_t fSelected;       // entries written
+   Double_t fTime[kSkimNStages];  // s, summed over the workers
+   std::vector<TString>  fCutNames;
+   std::vector<Long64_t> fCutPass;  // entries left after each cut
+};
+
+#endif
@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////
+// SkimTagProbe: trigger efficiency maps by tag and probe, from the
+// trigger-matching tuples (w_hlts/TwoMuonTwoTrigVertex and alike).
+//
+// The tag selects the candidates (a column != 0, or with one of the
+// bits of a mask set; none: all of them), the probe is the decision
+// measured (e.g. the kPhiFilter bit of "hlt"). Every tagged
+// candidate goes, by its probe, to the pass or the fail mass
+// histogram of its (pt, eta, lxy significance) bin. The tuples are
+// read once by all the threads, each a share of the entries with its
+// own counts, summed at the end. Then the pass and fail histograms of
+// every bin are fitted in parallel: Gaussian (or Voigtian) signal
+// over a Chebychev background, binned likelihood, the yields being
+// parameters of the fit. The efficiency of a bin is
+// nSig(pass) / (nSig(pass) + nSig(fail)).
+//
+//   SkimTagProbe tnp(0);
+//   tnp.Add("2Trak2MuonVertexTrig_tree.root");
+//   tnp.SetMass("xM", 80, 5.15, 5.55, 5.367, 0.01);
+//   tnp.SetProbe("hlt", SkimHLT::Bit(SkimHLT::kPhiFilter));
+//   tnp.SetTag("hlt", SkimHLT::Bit(SkimHLT::kTrakTrakFilter));
+//   tnp.SetBins(SkimTagProbe::kPt, "xPt", "0 10 15 20 30 50");
+//   tnp.SetBins(SkimTagProbe::kLxy, "lxysig", "0 2 3 5 10 50");
+//   tnp.Process("phiHLT_efficiency.root");
+//
+// An axis without SetBins() is one bin and its column is not read.
+// The output has, per bin, the pass/fail histograms and fitted
+// functions, the efficiency map (TH3D "efficiency", pt:eta:lxy) and
+// a tree "fits" with one row per bin; the table is also printed.
+// SetFit(kFALSE), and the histograms with fewer than SetMinEntries()
+// entries, count entries instead of fitting.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimTagProbe_h
+#define SkimTagProbe_h
+
+#include <TString.h>
+
+#include <vector>
+
+#include "SkimTriggerCatalog.h"
+
+class TTree;
+class TH1D;
+class TF1;
+
+class SkimTagProbe {
+public :
+   enum EAxis { kPt, kEta, kLxy, kNAxes };
+
+   SkimTagProbe(Int_t nThreads = 0);
+   virtual ~SkimTagProbe() { }
+
+   void     Add(const char *file, const char *treeName = "outuple");
+
+   void     SetNThreads(Int_t nThreads);
+   void     SetEntriesPerUnit(Long64_t entries) { fEntriesPerUnit = entries; }
+
+   // Fitted mass column and histogram range, signal peak and width
+   // to start the fits from (and the counting window, +-3 width)
+   void     SetMass(const char *column, Int_t nBins, Double_t min, Double_t max, Double_t peak, Double_t width);
+   // Decision measured, and the selection of the candidates (empty:
+   // all). mask 0: the column != 0, else any of its bits set in the
+   // column (integer trigger words, see SkimColumnWriter)
+   void     SetProbe(const char *column, UInt_t mask = 0) { fProbe = column; fProbeMask = mask; }
+   void     SetTag(const char *column, UInt_t mask = 0) { fTag = column; fTagMask = mask; }
+   // Blank separated bin edges of axis, on column
+   Bool_t   SetBins(Int_t axis, const char *column, const char *edges);
+
+   // Fits (default) or counts in the window
+   void     SetFit(Bool_t fit = kTRUE) { fDoFit = fit; }
+   // Signal shape: kFALSE Gaussian, kTRUE Voigtian of natural width gamma
+   void     SetSignal(Bool_t voigt, Double_t gamma = 0) { fVoigt = voigt; fGamma = gamma; }
+   // Order of the Chebychev background (0 to 4)
+   void     SetBackground(Int_t order) { fBkgOrder = order < 0 ? 0 : (order > 4 ? 4 : order); }
+   void     SetMinEntries(Int_t entries) { fMinEntries = entries; }
+
+   Int_t    GetNBins() const;
+
+   // Fills, fits and writes output, returns the candidates used (-1 on error)
+   Long64_t Process(const char *output);
+
+private :
+   struct Input {
+     TString fFile;
+     TString fTreeName;
+   };
+
+   struct Unit {
+     Int_t    fInput;
+     Long64_t fFirst;
+     Long64_t fLast;  // excluded
+   };
+
+   struct Axis {
+     TString               fColumn;
+     std::vector<Double_t> fEdges;
+   };
+
+   // Yield of one histogram
+   struct Yield {
+     Double_t fN;
+     Double_t fError;
+     Int_t    fStatus;  // of the fit, -1 counted
+   };
+
+   Bool_t   BuildUnits(std::vector<Unit> &units) const;
+   Long64_t Fill(std::vector<Double_t> &counts);
+   Bool_t   FillUnit(TTree *tree, const Unit &unit, std::vector<Double_t> &counts, Long64_t &used) const;
+   Int_t    FindBin(const Double_t *values) const;
+   static Bool_t Passes(Double_t value, UInt_t mask) { return mask ? ((ULong64_t) value & mask) != 0 : value != 0; }
+   TString  BinTitle(Int_t bin) const;
+   TString  ProbeName() const { return fProbeMask ? TString::Format("%s&0x%x", fProbe.Data(), fProbeMask) : fProbe; }
+   TF1     *MakeFunction(const char *name, const TH1D *hist) const;
+   Yield    Count(const TH1D *hist) const;
+   Yield    FitYield(TH1D *hist, TF1 *f) const;
+
+   std::vector<Input>    fInputs;
+   Int_t                 fNThreads;
+   Long64_t              fEntriesPerUnit;
+   TString               fMass;
+   Int_t                 fMassBins;
+   Double_t              fMassMin;
+   Double_t              fMassMax;
+   Double_t              fPeak;
+   Double_t              fWidth;
+   TString               fProbe;
+   UInt_t                fProbeMask;
+   TString               fTag;
+   UInt_t                fTagMask;
+   Axis                  fAxes[kNAxes];
+   Bool_t                fDoFit;
+   Bool_t                fVoigt;
+   Double_t              fGamma;
+   Int_t                 fBkgOrder;
+   Int_t                 fMinEntries;
+};
+
+#endif
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////
+// SkimTopology: description of one skim (input tree, output
+// tree, selection and copy) as driven by SkimEngine.
+//
+// It plays the role the generated TSelector used to play under
+// PROOF: Book() is the old SlaveBegin(), Init() is Init() and
+// Process() is Process(). Every worker thread of the engine
+// works on its own Clone(), so an implementation can keep its
+// per-entry state (readers, output buffers) in data members.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimTopology_h
+#define SkimTopology_h
+
+#include <TTree.h>
+#include <TString.h>
+#include <TError.h>
+
+#include <vector>
+
+#include "SkimStats.h"
+
+class SkimTopology {
+public :
+   SkimTopology(const char *treeName, const char *dirName, const char *outTreeName)
+     : fTreeName(treeName), fDirName(dirName), fOutTreeName(outTreeName), fStats(0) { }
+   virtual ~SkimTopology() { }
+
+   // A fresh, unbound copy for one worker thread
+   virtual SkimTopology *Clone() const = 0;
+
+   // Called once per worker, creates the output branches on outTree
+   virtual void    Book(TTree *outTree) = 0;
+
+   // Called every time the worker moves to a new input file
+   virtual void    Init(TTree *tree) = 0;
+
+   // Called for each entry of the input tree, kTRUE fills the output tree
+   virtual Bool_t  Process(Long64_t entry) = 0;
+
+   // Called for each unit of work [first, last), returns the number of
+   // entries written. Topologies able to work on many entries at once
+   // override this, the default just loops on Process(). With stats
+   // the whole loop is timed as select (Process() reads the entry).
+   virtual Long64_t ProcessRange(Long64_t first, Long64_t last, TTree *outTree)
+   {
+     SkimStats::Clock::time_point t;
+     if (fStats)
+       t = SkimStats::Clock::now();
+     Long64_t selected = 0;
+     for (Long64_t entry = first; entry < last; ++entry)
+       if (Process(entry))
+       {
+         outTree->Fill();
+         ++selected;
+       }
+     if (fStats)
+       fStats->Stamp(kSkimSelect, t);
+     return selected;
+   }
+
+   // Input branches read for every entry of a unit, cached and read
+   // ahead (see SkimReadAhead); the others are read on demand. None
+   // by default: the tree cache learns them on the first entries.
+   virtual void    GetRangeBranches(std::vector<TString> &names) const { names.clear(); }
+
+   // Stage times and cut-flow of the worker running this clone, 0 for
+   // none (the engine counts the entries). Set after Clone(), before
+   // Book(); timed per unit or block, never per entry.
+   virtual void    SetStats(SkimStats *stats) { fStats = stats; }
+
+   // Replaces the compiled-in selection by the cuts given at run
+   // time (see SkimSelection::ReadCuts), kFALSE if not supported
+   virtual Bool_t  SetCuts(const char *cuts)
+   {
+     ::Error("SkimTopology::SetCuts", "%s has no run time cuts, ignoring %s", fOutTreeName.Data(), cuts);
+     return kFALSE;
+   }
+
+   // Several run time selections evaluated in the same pass, entries
+   // passing any of them are written (see SkimEngine::AddVariant)
+   virtual Bool_t  SetVariants(const std::vector<TString> &)
+   {
+     ::Error("SkimTopology::SetVariants", "%s has no cut variants", fOutTreeName.Data());
+     return kFALSE;
+   }
+
+   const char *GetTreeName() const    { return fTreeName.Data(); }
+   const char *GetDirName() const     { return fDirName.Data(); }
+   const char *GetOutTreeName() const { return fOutTreeName.Data(); }
+
+protected :
+   TString fTreeName;     // input tree, e.g. "SixTracksTree"
+   TString fDirName;      // input directory, e.g. "rootupleSix"
+   TString fOutTreeName;  // output tree, e.g. "SixTrackSkimmedTree"
+   SkimStats *fStats;     // not owned
+};
+
+#endif
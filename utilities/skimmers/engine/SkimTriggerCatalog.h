@@ -0,0 +1,289 @@
+//////////////////////////////////////////////////////////
+// SkimTriggerCatalog: which HLT path is which bit of the trigger
+// words of the ntuples, per data-taking year, and the checks on
+// those words.
+//
+// The rootuplers store the decisions of the paths they know as the
+// bits of one word per event ("trigger"), and the trigger filters
+// matched by each candidate object as the bits of its tMatch word.
+// The skims used to test them with bitset<16>::test(n) and a bare n,
+// the names being known only to the hltsName list of
+// skimRunII_xmass.C. Both live here now:
+//
+//   if (SkimHLT::Test(*trigger, SkimHLT::kDoubleMu4_JpsiTrk_Displaced)) ...
+//   const UInt_t jpsi = SkimHLT::Mask(SkimHLT::kDimuon20_Jpsi_Barrel_Seagulls, SkimHLT::kDimuon25_Jpsi);
+//   if (SkimHLT::Any(*trigger, jpsi)) ...
+//   Int_t n = SkimHLT::Any(words, nWords, jpsi, pass);   // a batch of words
+//   SkimTriggerCatalog::GetName(2018, 8);                 // "HLT_DoubleMu4_Jpsi_Displaced"
+//   SkimTriggerCatalog::GetMask(2018, "HLT_Dimuon25_Jpsi HLT_Dimuon0_Jpsi");
+//
+// Store() adds the table of a year to the UserInfo of an output tree
+// (Write() to a directory, for outputs without a tree), so every
+// output tells which path each of its bits is; Load() reads it back.
+//
+// Years:
+//   2012       the ntuples keep the menu names, TwoMuTwoK_2012 builds
+//              the word from them (see SkimTriggerMenu); each bit
+//              accepts the path versions listed here
+//   2016-2018  the list of the Run II rootupler, the same for the
+//              three years (a path a year did not have never fires)
+// A trigger change is an edit of the tables below, the skims use the
+// names.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimTriggerCatalog_h
+#define SkimTriggerCatalog_h
+
+#include <Rtypes.h>
+#include <TString.h>
+#include <TNamed.h>
+#include <TList.h>
+#include <TTree.h>
+#include <TDirectory.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TError.h>
+
+#include <vector>
+
+namespace SkimHLT {
+
+// Bits of the "trigger" word of the Run II (2016-2018) ntuples
+enum ERunIIPath {
+  kDoubleMu2_Jpsi_DoubleTkMu0_Phi,
+  kDoubleMu2_Jpsi_DoubleTrk1_Phi,
+  kMu20_TkMu0_Phi,
+  kDimuon14_Phi_Barrel_Seagulls,
+  kMu25_TkMu0_Phi,
+  kDimuon24_Phi_noCorrL1,
+  kDoubleMu4_JpsiTrkTrk_Displaced,
+  kDoubleMu4_JpsiTrk_Displaced,
+  kDoubleMu4_Jpsi_Displaced,
+  kDoubleMu4_3_Jpsi_Displaced,
+  kDimuon20_Jpsi_Barrel_Seagulls,
+  kDimuon25_Jpsi,
+  kDimuon0_Jpsi,
+  kNRunIIPaths
+};
+
+// Bits of the 2012 word built by TwoMuTwoK_2012
+enum E2012Path {
+  k2012DoubleMu4_Jpsi_Displaced,
+  k2012Dimuon8_Jpsi,
+  kN2012Paths
+};
+
+// Bits of the tMatch words of the 2017 2k2Trig ntuples (filters of
+// the phi, track-track and track legs)
+enum EMatchFilter {
+  kPhiFilter,
+  kTrakTrakFilter,
+  kTrakFilter,
+  kNMatchFilters
+};
+
+constexpr UInt_t Bit(UInt_t k) { return 1u << k; }
+
+constexpr UInt_t Mask() { return 0; }
+
+// Word with the bits k, rest... set
+template <class... Rest>
+constexpr UInt_t Mask(UInt_t k, Rest... rest) { return Bit(k) | Mask(rest...); }
+
+constexpr Bool_t Test(UInt_t word, UInt_t k) { return (word >> k) & 1u; }
+
+// At least one, every bit of mask fired
+constexpr Bool_t Any(UInt_t word, UInt_t mask) { return (word & mask) != 0; }
+constexpr Bool_t All(UInt_t word, UInt_t mask) { return (word & mask) == mask; }
+
+// Bits set in every word (e.g. the tMatch of all the legs of a candidate)
+constexpr UInt_t Common(UInt_t word) { return word; }
+
+template <class... Rest>
+constexpr UInt_t Common(UInt_t word, Rest... rest) { return word & Common(rest...); }
+
+// Batches: pass[i] = Any/All(words[i], mask), returns how many passed.
+// Plain loops without branches, the compiler vectorizes them.
+inline Int_t Any(const UInt_t *words, Int_t n, UInt_t mask, UChar_t *pass)
+{
+  Int_t count = 0;
+  for (Int_t i = 0; i < n; ++i)
+  {
+    pass[i] = (words[i] & mask) != 0;
+    count += pass[i];
+  }
+  return count;
+}
+
+inline Int_t All(const UInt_t *words, Int_t n, UInt_t mask, UChar_t *pass)
+{
+  Int_t count = 0;
+  for (Int_t i = 0; i < n; ++i)
+  {
+    pass[i] = (words[i] & mask) == mask;
+    count += pass[i];
+  }
+  return count;
+}
+
+}
+
+class SkimTriggerCatalog {
+public :
+   // Year of the data of run, 0 outside the known ones
+   static Int_t   Year(UInt_t run)
+   {
+     if (run >= 190456 && run <= 208686) return 2012;
+     if (run >= 272007 && run <= 284044) return 2016;
+     if (run >= 294927 && run <= 306462) return 2017;
+     if (run >= 314472 && run <= 325175) return 2018;
+     return 0;
+   }
+
+   static Int_t   GetNBits(Int_t year)
+   {
+     Int_t n = 0;
+     Table(year, n);
+     return n;
+   }
+
+   // Path of bit k in year, "" if none
+   static const char *GetName(Int_t year, Int_t k)
+   {
+     Int_t n = 0;
+     const Path *paths = Table(year, n);
+     return k >= 0 && k < n ? paths[k].fName : "";
+   }
+
+   // Path versions accepted by bit k (blank separated), "" for any
+   static const char *GetVersions(Int_t year, Int_t k)
+   {
+     Int_t n = 0;
+     const Path *paths = Table(year, n);
+     return k >= 0 && k < n ? paths[k].fVersions : "";
+   }
+
+   // Bit of path in year (with or without "HLT_"), -1 if not in the table
+   static Int_t   GetBit(Int_t year, const char *path)
+   {
+     TString name = path;
+     if (!name.BeginsWith("HLT_"))
+       name.Prepend("HLT_");
+     Int_t n = 0;
+     const Path *paths = Table(year, n);
+     for (Int_t k = 0; k < n; ++k)
+       if (name == paths[k].fName)
+         return k;
+     return -1;
+   }
+
+   // Bits of the paths in names (blank or comma separated)
+   static UInt_t  GetMask(Int_t year, const char *names)
+   {
+     UInt_t mask = 0;
+     TObjArray *words = TString(names).Tokenize(" ,");
+     for (Int_t w = 0; w < words->GetEntriesFast(); ++w)
+     {
+       const TString &name = ((TObjString *) words->At(w))->GetString();
+       Int_t k = GetBit(year, name);
+       if (k < 0)
+         ::Warning("SkimTriggerCatalog::GetMask", "No %s in the %d triggers", name.Data(), year);
+       else
+         mask |= SkimHLT::Bit(k);
+     }
+     delete words;
+     return mask;
+   }
+
+   // Table of year as stored in the outputs: "<year>:<bit 0> <bit 1> ..."
+   static TNamed *Describe(Int_t year)
+   {
+     TString table = TString::Format("%d:", year);
+     for (Int_t k = 0; k < GetNBits(year); ++k)
+       table += TString(k ? " " : "") + GetName(year, k);
+     return new TNamed(Key(), table);
+   }
+
+   static void    Store(TTree *tree, Int_t year)
+   {
+     TList *info = tree->GetUserInfo();
+     TObject *old = info->FindObject(Key());
+     if (old)
+     {
+       info->Remove(old);
+       delete old;
+     }
+     info->Add(Describe(year));
+   }
+
+   static void    Write(TDirectory *dir, Int_t year)
+   {
+     TNamed *table = Describe(year);
+     dir->WriteTObject(table, Key(), "Overwrite");
+     delete table;
+   }
+
+   // Year and paths (by bit) stored in tree, 0 if none
+   static Int_t   Load(TTree *tree, std::vector<TString> &paths)
+   {
+     paths.clear();
+     TNamed *table = (TNamed *) tree->GetUserInfo()->FindObject(Key());
+     if (!table)
+       return 0;
+     TString title = table->GetTitle();
+     Int_t colon = title.Index(":");
+     TObjArray *words = TString(title(colon + 1, title.Length())).Tokenize(" ");
+     for (Int_t w = 0; w < words->GetEntriesFast(); ++w)
+       paths.push_back(((TObjString *) words->At(w))->GetString());
+     delete words;
+     return TString(title(0, colon)).Atoi();
+   }
+
+private :
+   struct Path {
+     const char *fName;
+     const char *fVersions;
+   };
+
+   static const char *Key() { return "SkimTriggers"; }
+
+   static const Path *Table(Int_t year, Int_t &n)
+   {
+     static const Path runII[SkimHLT::kNRunIIPaths] = {
+       { "HLT_DoubleMu2_Jpsi_DoubleTkMu0_Phi", "" },
+       { "HLT_DoubleMu2_Jpsi_DoubleTrk1_Phi",  "" },
+       { "HLT_Mu20_TkMu0_Phi",                 "" },
+       { "HLT_Dimuon14_Phi_Barrel_Seagulls",   "" },
+       { "HLT_Mu25_TkMu0_Phi",                 "" },
+       { "HLT_Dimuon24_Phi_noCorrL1",          "" },
+       { "HLT_DoubleMu4_JpsiTrkTrk_Displaced", "" },
+       { "HLT_DoubleMu4_JpsiTrk_Displaced",    "" },
+       { "HLT_DoubleMu4_Jpsi_Displaced",       "" },
+       { "HLT_DoubleMu4_3_Jpsi_Displaced",     "" },
+       { "HLT_Dimuon20_Jpsi_Barrel_Seagulls",  "" },
+       { "HLT_Dimuon25_Jpsi",                  "" },
+       { "HLT_Dimuon0_Jpsi",                   "" }
+     };
+     static const Path run2012[SkimHLT::kN2012Paths] = {
+       { "HLT_DoubleMu4_Jpsi_Displaced", "v9 v10 v11 v12" },
+       { "HLT_Dimuon8_Jpsi",             "v3 v4 v5 v6 v7" }
+     };
+
+     switch (year)
+     {
+       case 2012:
+         n = SkimHLT::kN2012Paths;
+         return run2012;
+       case 2016:
+       case 2017:
+       case 2018:
+         n = SkimHLT::kNRunIIPaths;
+         return runII;
+       default:
+         n = 0;
+         return 0;
+     }
+   }
+};
+
+#endif
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////
+// SkimTriggerMenu: HLT decisions of the paths a skim wants as a
+// bitmask, without looking at the trigger names of every event.
+//
+// The ntuplizers store the menu of the event (names) next to the
+// decisions, and the skimmers used to search every name for every
+// path version they accept, for every entry. The menu only changes
+// with the run, so here the names are read once per run: each
+// wanted path gets a bit, its positions in the menu are resolved
+// once per distinct menu (runs with the same menu share them) and
+// an event is the OR of the bits of the fired positions:
+//
+//   SkimTriggerMenu menu;
+//   Int_t v9 = menu.AddPath("HLT_DoubleMu4_Jpsi_Displaced_v9");
+//   ...
+//   if (!menu.SetRun(*runNum, TrigRes.GetSize()))
+//     menu.Resolve(TrigNames);
+//   ULong64_t fired = menu.Fired(TrigRes);
+//   Bool_t displaced = (fired & displacedMask) != 0;
+//
+// A path matches every name containing it, as the find() loops did.
+//////////////////////////////////////////////////////////
+
+#ifndef SkimTriggerMenu_h
+#define SkimTriggerMenu_h
+
+#include <Rtypes.h>
+#include <TString.h>
+#include <TError.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+class SkimTriggerMenu {
+public :
+   SkimTriggerMenu() : fCurrent(-1), fRun(0) { }
+
+   // Bit of path in Fired(), -1 past 64 paths
+   Int_t     AddPath(const char *path)
+   {
+     if (fPaths.size() >= 64)
+     {
+       ::Error("SkimTriggerMenu::AddPath", "At most 64 paths, ignoring %s", path);
+       return -1;
+     }
+     fPaths.push_back(path);
+     // Menus resolved so far do not know the new path
+     fMenus.clear();
+     fKeys.clear();
+     fRuns.clear();
+     fCurrent = -1;
+     return (Int_t) fPaths.size() - 1;
+   }
+
+   // Bits of every path added whose name contains part
+   ULong64_t Mask(const char *part) const
+   {
+     ULong64_t mask = 0;
+     for (UInt_t k = 0; k < fPaths.size(); ++k)
+       if (fPaths[k].find(part) != std::string::npos)
+         mask |= 1ull << k;
+     return mask;
+   }
+
+   Int_t     GetNPaths() const { return (Int_t) fPaths.size(); }
+
+   // Selects the menu already resolved for run, kFALSE when the names
+   // have to be given to Resolve() (new run, or a menu of another size)
+   Bool_t    SetRun(UInt_t run, Int_t nTriggers)
+   {
+     if (fCurrent >= 0 && run == fRun && nTriggers == fMenus[fCurrent].fSize)
+       return kTRUE;
+     std::map<UInt_t, Int_t>::const_iterator it = fRuns.find(run);
+     if (it == fRuns.end() || fMenus[it->second].fSize != nTriggers)
+     {
+       fRun = run;
+       fCurrent = -1;
+       return kFALSE;
+     }
+     fRun = run;
+     fCurrent = it->second;
+     return kTRUE;
+   }
+
+   // Positions of the paths in names (any container of std::string
+   // with GetSize()/size() and operator[]), for the run of SetRun()
+   template <class Names>
+   void      Resolve(const Names &names)
+   {
+     Int_t n = (Int_t) Size(names);
+     std::string key;
+     for (Int_t i = 0; i < n; ++i)
+       key.append(names[i]).push_back('\n');
+
+     std::map<std::string, Int_t>::const_iterator it = fKeys.find(key);
+     if (it != fKeys.end())
+       fCurrent = it->second;
+     else
+     {
+       Menu menu;
+       menu.fSize = n;
+       for (Int_t i = 0; i < n; ++i)
+         for (UInt_t k = 0; k < fPaths.size(); ++k)
+           if (std::string(names[i]).find(fPaths[k]) != std::string::npos)
+           {
+             menu.fPositions.push_back(i);
+             menu.fBits.push_back(1ull << k);
+           }
+       fMenus.push_back(menu);
+       fCurrent = (Int_t) fMenus.size() - 1;
+       fKeys[key] = fCurrent;
+     }
+     fRuns[fRun] = fCurrent;
+   }
+
+   // Bits of the paths that fired (decision == 1) in results
+   template <class Results>
+   ULong64_t Fired(const Results &results) const
+   {
+     if (fCurrent < 0)
+       return 0;
+     const Menu &menu = fMenus[fCurrent];
+     Int_t n = (Int_t) Size(results);
+     ULong64_t fired = 0;
+     for (UInt_t p = 0; p < menu.fPositions.size(); ++p)
+       if (menu.fPositions[p] < n && results[menu.fPositions[p]] == 1)
+         fired |= menu.fBits[p];
+     return fired;
+   }
+
+   // Distinct menus resolved so far
+   Int_t     GetNMenus() const { return (Int_t) fMenus.size(); }
+
+private :
+   struct Menu {
+     Int_t                   fSize;
+     std::vector<Int_t>      fPositions;  // in the menu, of the names matching a path
+     std::vector<ULong64_t>  fBits;       // bit of that path
+   };
+
+   template <class T> static size_t Size(const T &c) { return c.GetSize(); }
+   template <class T> static size_t Size(const std::vector<T> &c) { return c.size(); }
+
+   std::vector<std::string>       fPaths;
+   std::vector<Menu>              fMenus;
+   std::map<std::string, Int_t>   fKeys;  // menu names, '\n' separated
+   std::map<UInt_t, Int_t>        fRuns;
+   Int_t                          fCurrent;
+   UInt_t                         fRun;
+};
+
+#endif
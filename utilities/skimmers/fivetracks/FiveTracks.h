@@ -47,6 +47,9 @@
 
 // Headers needed by this particular selector
 #include "TLorentzVector.h"
+#include "../engine/SkimCandidates.h"
+
+#include <vector>
 
 
 
@@ -388,6 +391,18 @@ Float_t out_dimuonDiTrkOne_mmpp, out_dimuonDiTrkTwo_mmpp, out_dimuonDiTrkFour_mm
    TProofOutputFile *OutFile;
    TFile            *fOut;
 
+   // The selected candidates are kept fBatchSize at a time: their
+   // output rows and momenta, the masses of the whole batch computed
+   // by one kernel call per combination before the rows are filled
+   void  FlushCandidates();
+
+   const Int_t           fBatchSize = 1024;
+   SkimCandidateBatch    fCands = SkimCandidateBatch(4, 1024); //! dimuon and three tracks
+   std::vector<Float_t>  fDimuonE;                             //!
+   std::vector<Float_t>  fMasses;                              //! 6 x fBatchSize
+   std::vector<Float_t>  fRows;                                //! output rows of the batch
+   std::vector<Float_t*> fColumns;                             //! output branch addresses
+
    ClassDef(FiveTracks,0);
 
 };
@@ -0,0 +1,21 @@
+//////////////////////////////////////////////////////////
+// SkimEngine topology for the six tracks skim, same selection
+// as SixTracks::Process. The columns are listed once in
+// SixTracksTopology.C (kSixTracksColumns), adding a variable
+// means adding one line there.
+//////////////////////////////////////////////////////////
+
+#ifndef SixTracksTopology_h
+#define SixTracksTopology_h
+
+#include "../engine/SkimSchemaTopology.h"
+
+class SixTracksTopology : public SkimSchemaTopology {
+public :
+   SixTracksTopology();
+   virtual ~SixTracksTopology() { }
+
+   virtual SkimTopology *Clone() const { return new SixTracksTopology(); }
+};
+
+#endif
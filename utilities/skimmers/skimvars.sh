@@ -1,4 +1,5 @@
 echo "Use this script with the header generated by MakeSelector"
+echo "For SkimEngine topologies list the columns in a SkimColumn table instead (engine/SkimSchema.h)"
 
 grep -Eo 'fReader, "\w+' $1 > listofvars.txt #get variables
 sed -i -e 's/fReader, \"//g' listofvars.txt
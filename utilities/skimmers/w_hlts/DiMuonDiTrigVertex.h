@@ -26,6 +26,8 @@
 #include <TProof.h>
 #include <TProofOutputFile.h>
 
+#include "../engine/SkimColumnWriter.h"
+
 
 
 class DiMuonDiTrigVertex : public TSelector {
@@ -33,7 +35,7 @@ public :
    TTreeReader     fReader;  //!the tree reader
    TTree          *fChain = 0;   //!pointer to the analyzed TTree or TChain
 
-   TNtuple *outTuple;
+   SkimColumnWriter *outTuple;
 
    // Readers to access the data (delete the ones you do not need).
    TTreeReaderValue<UInt_t> run = {fReader, "run"};
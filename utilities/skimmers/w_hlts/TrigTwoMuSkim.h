@@ -26,14 +26,15 @@
 #include <TProof.h>
 #include <TProofOutputFile.h>
 
-#include <bitset>
+#include "../engine/SkimTriggerCatalog.h"
+#include "../engine/SkimColumnWriter.h"
 
 class TrigTwoMuSkim : public TSelector {
 public :
    TTreeReader     fReader;  //!the tree reader
    TTree          *fChain = 0;   //!pointer to the analyzed TTree or TChain
 
-   TNtuple *outTuple;
+   SkimColumnWriter *outTuple;
 
    // Readers to access the data (delete the ones you do not need).
    TTreeReaderValue<UInt_t> run = {fReader, "run"};
@@ -26,7 +26,8 @@
 #include <TProof.h>
 #include <TProofOutputFile.h>
 
-#include <bitset>
+#include "../engine/SkimTriggerCatalog.h"
+#include "../engine/SkimColumnWriter.h"
 
 
 class TwoMuTwoTrakTrigSkim : public TSelector {
@@ -34,7 +35,7 @@ public :
    TTreeReader     fReader;  //!the tree reader
    TTree          *fChain = 0;   //!pointer to the analyzed TTree or TChain
 
-   TNtuple *outTuple;
+   SkimColumnWriter *outTuple;
 
    // Readers to access the data (delete the ones you do not need).
    TTreeReaderValue<Int_t> run = {fReader, "run"};
@@ -28,7 +28,7 @@
 #include <TProof.h>
 #include <TProofOutputFile.h>
 
-#include <bitset>
+#include "../engine/SkimTriggerCatalog.h"
 
 class DiTrakSkim : public TSelector {
 public :